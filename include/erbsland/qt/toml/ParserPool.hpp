@@ -0,0 +1 @@
+#include "../../../../src/erbsland/qt/toml/ParserPool.hpp"
@@ -0,0 +1 @@
+#include "../../../../src/erbsland/qt/toml/ValueTableRef.hpp"
@@ -0,0 +1,198 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "DocumentCache.hpp"
+
+
+#include "Error.hpp"
+#include "Parser.hpp"
+#include "Snapshot.hpp"
+
+#include "impl/DataInputStream.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDateTime>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutexLocker>
+
+#include <iterator>
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+DocumentCache::DocumentCache(Specification specification) noexcept
+    : _specification{specification} {
+}
+
+
+DocumentCache::~DocumentCache() = default;
+
+
+void DocumentCache::setMaximumDocumentCount(std::size_t count) noexcept {
+    QMutexLocker locker{&_mutex};
+    _maximumDocumentCount = count;
+    evictEntries();
+}
+
+
+void DocumentCache::setMaximumDataSize(std::size_t size) noexcept {
+    QMutexLocker locker{&_mutex};
+    _maximumDataSize = size;
+    evictEntries();
+}
+
+
+void DocumentCache::setValueArenaEnabled(bool enabled) noexcept {
+    QMutexLocker locker{&_mutex};
+    _isValueArenaEnabled = enabled;
+}
+
+
+void DocumentCache::setValueLocationsEnabled(bool enabled) noexcept {
+    QMutexLocker locker{&_mutex};
+    _isValueLocationEnabled = enabled;
+}
+
+
+auto DocumentCache::parseFileOrThrow(const QString &path) -> std::shared_ptr<const Value> {
+    const QFileInfo fileInfo{path};
+    const auto fileSize = static_cast<int64_t>(fileInfo.size());
+    const auto modificationTime = static_cast<int64_t>(fileInfo.lastModified().toMSecsSinceEpoch());
+    bool hasCachedContent = false;
+    uint64_t cachedContentChecksum = 0;
+    bool isValueArenaEnabled;
+    bool isValueLocationEnabled;
+    {
+        QMutexLocker locker{&_mutex};
+        if (const auto entry = _index.value(path, _entries.end()); entry != _entries.end()) {
+            if (entry->fileSize == fileSize && entry->modificationTime == modificationTime) {
+                _entries.splice(_entries.begin(), _entries, entry);
+                _statistics.hitCount += 1;
+                return entry->document;
+            }
+            hasCachedContent = true;
+            cachedContentChecksum = entry->contentChecksum;
+        }
+        isValueArenaEnabled = _isValueArenaEnabled;
+        isValueLocationEnabled = _isValueLocationEnabled;
+    }
+    // The file changed, or is not cached. Read the content, to test if it actually changed. The file is not
+    // mapped into memory, as it may be changed while it is read.
+    QFile file{path};
+    if (!file.open(QIODevice::ReadOnly)) {
+        remove(path);
+        throw Error::createIO(path, file);
+    }
+    const auto data = file.readAll();
+    if (file.error() != QFileDevice::NoError) {
+        remove(path);
+        throw Error::createIO(path, file);
+    }
+    const auto contentChecksum = Snapshot::sourceChecksum(data);
+    if (hasCachedContent && contentChecksum == cachedContentChecksum) {
+        QMutexLocker locker{&_mutex};
+        const auto entry = _index.value(path, _entries.end());
+        if (entry != _entries.end() && entry->contentChecksum == contentChecksum) {
+            _statistics.dataSize -= static_cast<std::size_t>(entry->fileSize);
+            _statistics.dataSize += static_cast<std::size_t>(fileSize);
+            entry->fileSize = fileSize;
+            entry->modificationTime = modificationTime;
+            _entries.splice(_entries.begin(), _entries, entry);
+            _statistics.hitCount += 1;
+            return entry->document;
+        }
+    }
+    Parser parser{_specification};
+    parser.setValueArenaEnabled(isValueArenaEnabled);
+    parser.setValueLocationsEnabled(isValueLocationEnabled);
+    std::shared_ptr<const Value> document;
+    try {
+        document = parser.parseStreamOrThrow(std::make_shared<impl::DataInputStream>(data, path));
+    } catch (const Error&) {
+        remove(path);
+        throw;
+    }
+    insertEntry(Entry{path, fileSize, modificationTime, contentChecksum, document});
+    return document;
+}
+
+
+auto DocumentCache::parseFile(const QString &path) noexcept -> std::shared_ptr<const Value> {
+    try {
+        return parseFileOrThrow(path);
+    } catch (const Error&) {
+        return {};
+    }
+}
+
+
+void DocumentCache::remove(const QString &path) noexcept {
+    QMutexLocker locker{&_mutex};
+    if (const auto entry = _index.value(path, _entries.end()); entry != _entries.end()) {
+        removeEntry(entry);
+    }
+}
+
+
+void DocumentCache::clear() noexcept {
+    QMutexLocker locker{&_mutex};
+    _entries.clear();
+    _index.clear();
+    _statistics.documentCount = 0;
+    _statistics.dataSize = 0;
+}
+
+
+auto DocumentCache::statistics() const noexcept -> Statistics {
+    QMutexLocker locker{&_mutex};
+    return _statistics;
+}
+
+
+void DocumentCache::resetStatistics() noexcept {
+    QMutexLocker locker{&_mutex};
+    _statistics.hitCount = 0;
+    _statistics.missCount = 0;
+    _statistics.evictionCount = 0;
+}
+
+
+void DocumentCache::insertEntry(Entry entry) noexcept {
+    QMutexLocker locker{&_mutex};
+    _statistics.missCount += 1;
+    if (const auto previous = _index.value(entry.path, _entries.end()); previous != _entries.end()) {
+        removeEntry(previous);
+    }
+    if (static_cast<std::size_t>(entry.fileSize) > _maximumDataSize) {
+        return; // the document would evict all other documents and then itself.
+    }
+    _statistics.documentCount += 1;
+    _statistics.dataSize += static_cast<std::size_t>(entry.fileSize);
+    _entries.emplace_front(std::move(entry));
+    _index.insert(_entries.front().path, _entries.begin());
+    evictEntries();
+}
+
+
+void DocumentCache::removeEntry(EntryList::iterator entry) noexcept {
+    _statistics.documentCount -= 1;
+    _statistics.dataSize -= static_cast<std::size_t>(entry->fileSize);
+    _index.remove(entry->path);
+    _entries.erase(entry);
+}
+
+
+void DocumentCache::evictEntries() noexcept {
+    while (!_entries.empty()
+        && (_statistics.documentCount > _maximumDocumentCount || _statistics.dataSize > _maximumDataSize)) {
+        removeEntry(std::prev(_entries.end()));
+        _statistics.evictionCount += 1;
+    }
+}
+
+
+}
+
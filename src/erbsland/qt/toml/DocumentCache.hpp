@@ -0,0 +1,192 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Namespace.hpp"
+#include "Specification.hpp"
+#include "Value.hpp"
+
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+
+
+namespace erbsland::qt::toml {
+
+
+/// A thread-safe cache for parsed documents, that are read from files.
+///
+/// Components that read the same shared files, e.g. common include files, get the same parsed document
+/// from the cache. A file is only read again if its size or modification time changed, and only parsed
+/// again if the content also changed. The least recently used documents are removed from the cache if it
+/// exceeds the maximum number of documents or the maximum data size.
+///
+/// @code
+/// static DocumentCache cache;
+/// auto toml = cache.parseFileOrThrow(path);
+/// auto name = toml->stringValue(QStringLiteral("main.name"));
+/// @endcode
+///
+/// The documents are shared with all callers and threads. The returned pointer is to a constant root value,
+/// but this is only a shallow protection: the accessors of `Value` return the child values as non-constant
+/// pointers. Modifying a cached document, or any of its values, is undefined behaviour. If you need to
+/// modify a document, parse the file with `Parser` instead.
+///
+/// @note You can call all methods of one cache from multiple threads at the same time.
+///
+class DocumentCache final {
+    // fwd-entry: class DocumentCache
+
+public:
+    /// The counters of a cache.
+    ///
+    struct Statistics {
+        std::size_t hitCount{}; ///< The number of requests that returned a cached document.
+        std::size_t missCount{}; ///< The number of requests that parsed the document.
+        std::size_t evictionCount{}; ///< The number of documents that were removed to meet the limits.
+        std::size_t documentCount{}; ///< The number of documents in the cache.
+        std::size_t dataSize{}; ///< The size of the files of the documents in the cache, in bytes.
+    };
+
+    /// The default maximum number of documents in the cache.
+    ///
+    static constexpr std::size_t cDefaultMaximumDocumentCount = 128;
+
+    /// The default maximum size of the files of the documents in the cache, in bytes.
+    ///
+    static constexpr std::size_t cDefaultMaximumDataSize = 64U * 1024U * 1024U;
+
+public:
+    /// Create a new empty document cache.
+    ///
+    /// @param specification The version of the specification to use for parsing.
+    ///
+    explicit DocumentCache(Specification specification = Specification::Version_1_0) noexcept;
+
+    /// dtor
+    ///
+    ~DocumentCache();
+
+    // no copy and assignment.
+    DocumentCache(const DocumentCache&) = delete;
+    auto operator=(const DocumentCache&) = delete;
+
+public: // options
+    /// Set the maximum number of documents in the cache.
+    ///
+    /// @param count The maximum number of documents. The default is `cDefaultMaximumDocumentCount`.
+    ///
+    void setMaximumDocumentCount(std::size_t count) noexcept;
+
+    /// Set the maximum size of the files of the documents in the cache.
+    ///
+    /// The size of the parsed values is not measured. It grows with the size of the file, so the size of
+    /// the files is used as a limit instead. Documents that are larger than the limit are not cached.
+    ///
+    /// @param size The maximum size in bytes. The default is `cDefaultMaximumDataSize`.
+    ///
+    void setMaximumDataSize(std::size_t size) noexcept;
+
+    /// Set if the values of parsed documents are allocated in a value arena.
+    ///
+    /// Documents that are already in the cache are not affected.
+    ///
+    /// @see Parser::setValueArenaEnabled()
+    ///
+    void setValueArenaEnabled(bool enabled) noexcept;
+
+    /// Set if the location ranges are stored in the parsed values.
+    ///
+    /// Documents that are already in the cache are not affected.
+    ///
+    /// @see Parser::setValueLocationsEnabled()
+    ///
+    void setValueLocationsEnabled(bool enabled) noexcept;
+
+public: // access
+    /// Get the parsed document for a file.
+    ///
+    /// If the file changed since it was parsed, it is parsed again. If multiple threads request the same
+    /// changed file at the same time, each of them may parse it.
+    ///
+    /// @param path The absolute path to the file.
+    /// @return The shared root table of the document.
+    /// @throws Error if the file cannot be read or contains an error. The file is removed from the cache.
+    ///
+    [[nodiscard]] auto parseFileOrThrow(const QString &path) -> std::shared_ptr<const Value>;
+
+    /// Get the parsed document for a file.
+    ///
+    /// @param path The absolute path to the file.
+    /// @return The shared root table of the document, or `nullptr` if there was an error.
+    ///
+    [[nodiscard]] auto parseFile(const QString &path) noexcept -> std::shared_ptr<const Value>;
+
+    /// Remove the document for a file from the cache.
+    ///
+    /// @param path The absolute path to the file.
+    ///
+    void remove(const QString &path) noexcept;
+
+    /// Remove all documents from the cache.
+    ///
+    void clear() noexcept;
+
+    /// Get the counters of this cache.
+    ///
+    [[nodiscard]] auto statistics() const noexcept -> Statistics;
+
+    /// Reset the hit, miss and eviction counters to zero.
+    ///
+    void resetStatistics() noexcept;
+
+private:
+    /// A cached document.
+    ///
+    struct Entry {
+        QString path; ///< The path to the file.
+        int64_t fileSize; ///< The size of the file.
+        int64_t modificationTime; ///< The modification time of the file, in milliseconds since the epoch.
+        uint64_t contentChecksum; ///< The checksum of the content of the file, see `Snapshot::sourceChecksum()`.
+        std::shared_ptr<const Value> document; ///< The parsed document.
+    };
+
+    /// The list of entries, with the most recently used entry first.
+    ///
+    using EntryList = std::list<Entry>;
+
+    /// Add a parsed document, or replace the cached document for the same file.
+    ///
+    /// @param entry The new entry.
+    ///
+    void insertEntry(Entry entry) noexcept;
+
+    /// Remove an entry, while the mutex is locked.
+    ///
+    void removeEntry(EntryList::iterator entry) noexcept;
+
+    /// Remove the least recently used entries until the cache meets the limits, while the mutex is locked.
+    ///
+    void evictEntries() noexcept;
+
+private:
+    Specification _specification; ///< The specification for parsing.
+    mutable QMutex _mutex; ///< The mutex to protect all following members.
+    std::size_t _maximumDocumentCount{cDefaultMaximumDocumentCount}; ///< The maximum number of documents.
+    std::size_t _maximumDataSize{cDefaultMaximumDataSize}; ///< The maximum size of all files.
+    bool _isValueArenaEnabled{false}; ///< If the value arena is enabled.
+    bool _isValueLocationEnabled{true}; ///< If the value locations are stored.
+    EntryList _entries; ///< The cached documents, with the most recently used first.
+    QHash<QString, EntryList::iterator> _index; ///< The entries by path.
+    Statistics _statistics; ///< The counters.
+};
+
+
+}
+
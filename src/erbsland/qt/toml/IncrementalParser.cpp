@@ -0,0 +1,129 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "IncrementalParser.hpp"
+
+
+#include "InputStream.hpp"
+
+#include "impl/ParserData.hpp"
+#include "impl/SectionScanner.hpp"
+#include "impl/StatementScanner.hpp"
+
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+IncrementalParser::IncrementalParser(Specification specification) noexcept
+    : d{new impl::ParserData{specification}}, _scanner{new impl::StatementScanner} {
+}
+
+
+IncrementalParser::~IncrementalParser() {
+    delete _scanner;
+    delete d;
+}
+
+
+void IncrementalParser::setValueArenaEnabled(bool enabled) noexcept {
+    d->setValueArenaEnabled(enabled);
+}
+
+
+void IncrementalParser::setValueLocationsEnabled(bool enabled) noexcept {
+    d->setValueLocationEnabled(enabled);
+}
+
+
+void IncrementalParser::feedOrThrow(const QByteArray &data) {
+    if (_hasFailed) {
+        throw d->lastError();
+    }
+    if (!_isStarted) {
+        d->beginIncrementalParse();
+        _isStarted = true;
+    }
+    _pendingData.append(data);
+    try {
+        parsePendingStatements();
+    } catch (const Error&) {
+        _hasFailed = true;
+        _pendingData.clear();
+        _scanner->reset();
+        throw;
+    } catch (std::exception&) {
+        reset();
+        throw;
+    }
+}
+
+
+auto IncrementalParser::finishOrThrow() -> ValuePtr {
+    if (_hasFailed) {
+        reset();
+        throw d->lastError();
+    }
+    if (!_isStarted) {
+        d->beginIncrementalParse();
+    }
+    const auto pendingData = std::exchange(_pendingData, {});
+    const auto pendingLocation = std::exchange(_pendingLocation, {});
+    _scanner->reset();
+    _isStarted = false; // the next call to `feed()` starts a new document.
+    return d->finishIncrementalParse(InputStream::createFromData(pendingData), pendingLocation);
+}
+
+
+auto IncrementalParser::feed(const QByteArray &data) noexcept -> bool {
+    try {
+        feedOrThrow(data);
+        return true;
+    } catch (const Error &error) {
+        return false;
+    }
+}
+
+
+auto IncrementalParser::finish() noexcept -> ValuePtr {
+    try {
+        return finishOrThrow();
+    } catch (const Error &error) {
+        return {};
+    }
+}
+
+
+void IncrementalParser::reset() noexcept {
+    d->abortParse();
+    _pendingData.clear();
+    _pendingLocation = {};
+    _scanner->reset();
+    _isStarted = false;
+    _hasFailed = false;
+}
+
+
+auto IncrementalParser::lastError() const noexcept -> const Error& {
+    return d->lastError();
+}
+
+
+void IncrementalParser::parsePendingStatements() {
+    // The scanner only scans the data that was added since the last call. If the data is invalid, the
+    // returned part ends with the invalid byte, and parsing it throws the syntax error.
+    const auto length = _scanner->scan(_pendingData);
+    if (length == 0) {
+        return;
+    }
+    // The part refers to the pending data, which is not modified while the part is parsed.
+    const auto part = QByteArray::fromRawData(_pendingData.constData(), length);
+    d->parseIncrementalPart(InputStream::createFromData(part), _pendingLocation);
+    _pendingLocation = impl::SectionScanner::locationAfter(_pendingData, 0, length, _pendingLocation);
+    _pendingData.remove(0, length);
+}
+
+
+}
+
@@ -0,0 +1,138 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Error.hpp"
+#include "Location.hpp"
+#include "Namespace.hpp"
+#include "Specification.hpp"
+#include "Value.hpp"
+
+#include <QtCore/QByteArray>
+
+
+namespace erbsland::qt::toml {
+
+
+namespace impl {
+class ParserData;
+class StatementScanner;
+}
+
+
+/// A parser for documents that are received in parts.
+///
+/// Instead of reading the document from a stream, the data is pushed into the parser as it arrives, e.g. from
+/// a socket or a pipe. Each call to `feed()` parses all statements of the document that are complete, and
+/// keeps the state of the document for the next call. A statement that is cut, e.g. inside a string, a number
+/// or a multi-line value, is kept until the rest of it arrives. So the parsing overlaps with the I/O, and no
+/// call ever waits for more data.
+///
+/// @code
+/// IncrementalParser parser;
+/// // for every block of data, e.g. in a slot connected to `QIODevice::readyRead`:
+/// if (!parser.feed(socket->readAll())) {
+///     qWarning() << parser.lastError().toString();
+/// }
+/// // after the last block of data:
+/// auto toml = parser.finish();
+/// @endcode
+///
+/// The parsed document and all errors are the same as if the complete data was parsed using
+/// `Parser::parseData()`.
+///
+class IncrementalParser final {
+    // fwd-entry: class IncrementalParser
+
+public:
+    /// Create a new incremental parser.
+    ///
+    /// @param specification The version of the specification to use for parsing.
+    ///
+    explicit IncrementalParser(Specification specification = Specification::Version_1_0) noexcept;
+
+    /// dtor
+    ///
+    ~IncrementalParser();
+
+    // no copy and assignment.
+    IncrementalParser(const IncrementalParser&) = delete;
+    auto operator=(const IncrementalParser&) = delete;
+
+public: // options
+    /// Set if the values of parsed documents are allocated in a value arena.
+    ///
+    /// @see Parser::setValueArenaEnabled()
+    /// @note The option is used for the next document, if it is changed while a document is parsed.
+    ///
+    void setValueArenaEnabled(bool enabled) noexcept;
+
+    /// Set if the location ranges are stored in the parsed values.
+    ///
+    /// @see Parser::setValueLocationsEnabled()
+    ///
+    void setValueLocationsEnabled(bool enabled) noexcept;
+
+public: // methods that throw exceptions.
+    /// Feed the next block of data of the document.
+    ///
+    /// The first call after creating the parser, or after the last document was finished, starts a new document.
+    ///
+    /// @param data The next block of the UTF-8 encoded document.
+    /// @throws Error on any problem with the data. After an error, all calls to this method throw the
+    ///     same error, until the document is finished with `finishOrThrow()` or the parser is reset.
+    ///
+    void feedOrThrow(const QByteArray &data);
+
+    /// Finish the document after the last block of data.
+    ///
+    /// @return A value that contains the parsed TOML data. This is always the special *root table*.
+    /// @throws Error on any problem with the data, or if there was an error with a previous block.
+    ///
+    [[nodiscard]] auto finishOrThrow() -> ValuePtr;
+
+public: // methods that do not throw exceptions.
+    /// Feed the next block of data of the document.
+    ///
+    /// @param data The next block of the UTF-8 encoded document.
+    /// @return `true` on success, `false` if there was an error. Use `lastError()` to get the error.
+    ///
+    auto feed(const QByteArray &data) noexcept -> bool;
+
+    /// Finish the document after the last block of data.
+    ///
+    /// @return A value that contains the parsed TOML data, or a `nullptr` if there was an error.
+    ///     Use `lastError()` to get the error.
+    ///
+    [[nodiscard]] auto finish() noexcept -> ValuePtr;
+
+    /// Discard the current document and all data that was fed.
+    ///
+    void reset() noexcept;
+
+    /// Access the last error.
+    ///
+    /// @return The last error from feeding or finishing a document. When called after a successful call,
+    ///    or before any data was fed, the behaviour is save but undefined.
+    ///
+    [[nodiscard]] auto lastError() const noexcept -> const Error&;
+
+private:
+    /// Parse the complete statements in the pending data.
+    ///
+    void parsePendingStatements();
+
+private:
+    impl::ParserData *d; ///< The implementation of the parser.
+    impl::StatementScanner *_scanner; ///< The scanner for the complete statements in the pending data.
+    QByteArray _pendingData; ///< The data that was not parsed yet, starting with an incomplete statement.
+    Location _pendingLocation; ///< The location of the pending data in the document.
+    bool _isStarted{false}; ///< If a document was started.
+    bool _hasFailed{false}; ///< If there was an error in the current document.
+};
+
+
+}
+
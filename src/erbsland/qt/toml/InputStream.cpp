@@ -4,11 +4,15 @@
 #include "InputStream.hpp"
 
 
+#include "Error.hpp"
+
 #include "impl/DataInputStream.hpp"
 #include "impl/FileInputStream.hpp"
+#include "impl/MappedFileInputStream.hpp"
 #include "impl/StringInputStream.hpp"
 
 #include <memory>
+#include <utility>
 
 
 namespace erbsland::qt::toml {
@@ -18,6 +22,26 @@ InputStream::InputStream(InputStream::Type type) noexcept : _type{type} {
 }
 
 
+auto InputStream::readBlockOrThrow(Char *buffer, qsizetype maximumSize) -> qsizetype {
+    if (_pendingError) {
+        std::rethrow_exception(std::exchange(_pendingError, {}));
+    }
+    qsizetype count = 0;
+    try {
+        while (count < maximumSize && !atEnd()) {
+            buffer[count] = readOrThrow();
+            count += 1;
+        }
+    } catch (const Error&) {
+        if (count == 0) {
+            throw;
+        }
+        _pendingError = std::current_exception(); // report the error after the characters read before.
+    }
+    return count;
+}
+
+
 auto InputStream::createFromString(const QString &text) noexcept -> InputStreamPtr {
     return std::make_unique<impl::StringInputStream>(text);
 }
@@ -33,5 +57,10 @@ auto InputStream::createFromFileOrThrow(const QString &path) -> InputStreamPtr {
 }
 
 
+auto InputStream::createFromMappedFileOrThrow(const QString &path) -> InputStreamPtr {
+    return std::make_unique<impl::MappedFileInputStream>(path);
+}
+
+
 }
 
@@ -13,6 +13,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QChar>
 
+#include <exception>
 #include <memory>
 
 
@@ -65,6 +66,20 @@ public:
     ///
     virtual auto readOrThrow() -> Char = 0;
 
+    /// Read a block of unicode characters from the stream.
+    ///
+    /// The parser reads the document using this method, so there is one call per block and not one call
+    /// per character. The default implementation calls `readOrThrow()` for each character. If an error
+    /// occurs after some characters were read, these characters are returned and the error is thrown
+    /// with the next call. Override this method, if your stream can decode many characters in one pass.
+    ///
+    /// @param buffer The buffer for the read characters.
+    /// @param maximumSize The maximum number of characters to read into the buffer. Must be greater than zero.
+    /// @return The number of characters read. Zero is only returned at the end of the stream.
+    /// @throws Error if there is an encoding error in the data or an IO error while reading the file.
+    ///
+    virtual auto readBlockOrThrow(Char *buffer, qsizetype maximumSize) -> qsizetype;
+
     /// Get a document string for an exception.
     ///
     [[nodiscard]] virtual auto document() const noexcept -> QString = 0;
@@ -92,6 +107,22 @@ public:
     ///
     static auto createFromFileOrThrow(const QString &path) -> InputStreamPtr;
 
+    /// Create a new input stream for a memory mapped file.
+    ///
+    /// The file is mapped into memory and the data is decoded directly from the mapping, without copying it.
+    /// If the file cannot be mapped, the stream transparently falls back to reading the file like
+    /// `createFromFileOrThrow()`.
+    ///
+    /// @warning If the file is truncated by another process while the stream is in use, accessing the mapping
+    ///     can terminate the process (e.g. with `SIGBUS` on POSIX systems). Use `createFromFileOrThrow()`
+    ///     for files that may be modified while they are read.
+    ///
+    /// @param path The path to the file.
+    /// @return The input stream.
+    /// @throws Error if the file does not exist or cannot be opened.
+    ///
+    static auto createFromMappedFileOrThrow(const QString &path) -> InputStreamPtr;
+
 protected:
     /// Create a new input stream of a given type.
     ///
@@ -99,6 +130,7 @@ protected:
 
 private:
     Type _type{Type::String}; ///< The type of the input stream.
+    std::exception_ptr _pendingError{}; ///< An error that occurred after the characters of the last block.
 };
 
 
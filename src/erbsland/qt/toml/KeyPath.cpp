@@ -0,0 +1,38 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "KeyPath.hpp"
+
+
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+KeyPath::KeyPath(QStringView keyPath) noexcept {
+    qsizetype start = 0;
+    for (;;) {
+        const auto separator = keyPath.indexOf(QChar('.'), start);
+        if (separator < 0) {
+            _keys.append(keyPath.mid(start).toString());
+            break;
+        }
+        _keys.append(keyPath.mid(start, separator - start).toString());
+        start = separator + 1;
+    }
+}
+
+
+KeyPath::KeyPath(QStringList keys) noexcept
+    : _keys{std::move(keys)} {
+}
+
+
+auto KeyPath::toString() const noexcept -> QString {
+    return _keys.join(QChar('.'));
+}
+
+
+}
+
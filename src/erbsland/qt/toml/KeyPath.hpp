@@ -0,0 +1,101 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Namespace.hpp"
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QStringView>
+
+
+namespace erbsland::qt::toml {
+
+
+/// A compiled key path to access values in a table.
+///
+/// A key path is split into its keys once, when it is created. Access with a key path does not allocate
+/// any memory, so you can keep key paths for values that are frequently read.
+///
+/// @code
+/// static const auto cIpAddress = KeyPath{QStringLiteral("server.ip-address")};
+/// auto ipAddress = rootTable->stringValue(cIpAddress, QStringLiteral("127.0.0.1"));
+/// @endcode
+///
+class KeyPath final {
+    // fwd-entry: class KeyPath
+
+public:
+    /// Create an empty key path.
+    ///
+    /// An empty key path does not point to any value.
+    ///
+    KeyPath() = default;
+
+    /// Create a key path from a string.
+    ///
+    /// @param keyPath The key path in the form `key.key.key`.
+    ///
+    explicit KeyPath(QStringView keyPath) noexcept;
+
+    /// Create a key path from single keys.
+    ///
+    /// Use this constructor if the keys contain a dot.
+    ///
+    /// @param keys The keys of the path, starting with the key in the first table.
+    ///
+    explicit KeyPath(QStringList keys) noexcept;
+
+    // defaults
+    /// @private
+    /// copy
+    KeyPath(const KeyPath&) = default;
+    /// @private
+    /// move
+    KeyPath(KeyPath&&) noexcept = default;
+    /// @private
+    /// assign
+    auto operator=(const KeyPath&) -> KeyPath& = default;
+    /// @private
+    /// move assign
+    auto operator=(KeyPath&&) noexcept -> KeyPath& = default;
+    /// @private
+    /// dtor
+    ~KeyPath() = default;
+
+public: // operators
+    /// Compare two key paths.
+    ///
+    [[nodiscard]] auto operator==(const KeyPath &other) const noexcept -> bool { return _keys == other._keys; }
+    /// Compare two key paths.
+    ///
+    [[nodiscard]] auto operator!=(const KeyPath &other) const noexcept -> bool { return _keys != other._keys; }
+
+public: // access
+    /// Test if this key path is empty.
+    ///
+    [[nodiscard]] inline auto isEmpty() const noexcept -> bool { return _keys.isEmpty(); }
+
+    /// Get the number of keys in this path.
+    ///
+    [[nodiscard]] inline auto size() const noexcept -> qsizetype { return _keys.size(); }
+
+    /// Access the keys of this path.
+    ///
+    [[nodiscard]] inline auto keys() const noexcept -> const QStringList& { return _keys; }
+
+    /// Convert this key path into a string.
+    ///
+    /// @return The keys of this path, separated with a dot.
+    ///
+    [[nodiscard]] auto toString() const noexcept -> QString;
+
+private:
+    QStringList _keys; ///< The keys of this path.
+};
+
+
+}
+
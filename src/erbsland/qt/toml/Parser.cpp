@@ -19,6 +19,31 @@ Parser::~Parser() {
 }
 
 
+void Parser::setValueArenaEnabled(bool enabled) noexcept {
+    d->setValueArenaEnabled(enabled);
+}
+
+
+void Parser::setValueLocationsEnabled(bool enabled) noexcept {
+    d->setValueLocationEnabled(enabled);
+}
+
+
+void Parser::setLazyValuesEnabled(bool enabled) noexcept {
+    d->setLazyValuesEnabled(enabled);
+}
+
+
+void Parser::setFileMappingEnabled(bool enabled) noexcept {
+    d->setFileMappingEnabled(enabled);
+}
+
+
+void Parser::setParallelParsingEnabled(bool enabled) noexcept {
+    d->setParallelParsingEnabled(enabled);
+}
+
+
 auto Parser::parseStringOrThrow(const QString &str) -> ValuePtr {
     return parseStreamOrThrow(InputStream::createFromString(str));
 }
@@ -30,7 +55,7 @@ auto Parser::parseDataOrThrow(const QByteArray &data) -> ValuePtr {
 
 
 auto Parser::parseFileOrThrow(const QString &path) -> ValuePtr {
-    return parseStreamOrThrow(InputStream::createFromFileOrThrow(path));
+    return parseStreamOrThrow(createFileStreamOrThrow(path));
 }
 
 
@@ -39,6 +64,26 @@ auto Parser::parseStreamOrThrow(const InputStreamPtr &inputStream) -> ValuePtr {
 }
 
 
+void Parser::parseStringOrThrow(const QString &str, ParserHandler &handler) {
+    parseStreamOrThrow(InputStream::createFromString(str), handler);
+}
+
+
+void Parser::parseDataOrThrow(const QByteArray &data, ParserHandler &handler) {
+    parseStreamOrThrow(InputStream::createFromData(data), handler);
+}
+
+
+void Parser::parseFileOrThrow(const QString &path, ParserHandler &handler) {
+    parseStreamOrThrow(createFileStreamOrThrow(path), handler);
+}
+
+
+void Parser::parseStreamOrThrow(const InputStreamPtr &inputStream, ParserHandler &handler) {
+    d->parseStream(inputStream, handler);
+}
+
+
 auto Parser::parseString(const QString &str) noexcept -> ValuePtr {
     try {
         return parseStringOrThrow(str);
@@ -80,5 +125,13 @@ auto Parser::lastError() const noexcept -> const Error& {
 }
 
 
+auto Parser::createFileStreamOrThrow(const QString &path) const -> InputStreamPtr {
+    if (d->isFileMappingEnabled()) {
+        return InputStream::createFromMappedFileOrThrow(path);
+    }
+    return InputStream::createFromFileOrThrow(path);
+}
+
+
 }
 
@@ -5,6 +5,7 @@
 
 
 #include "InputStream.hpp"
+#include "ParserHandler.hpp"
 #include "Specification.hpp"
 #include "Namespace.hpp"
 #include "Value.hpp"
@@ -44,6 +45,84 @@ public:
     Parser(const Parser&) = delete;
     auto operator=(const Parser&) = delete;
 
+public: // options
+    /// Set if the values of parsed documents are allocated in a value arena.
+    ///
+    /// By default, every value is a separate shared object. If the arena is enabled, all values of a
+    /// parsed document are allocated in large blocks, which are owned by the document. This avoids one heap
+    /// allocation per value and keeps the values close together in memory. All values are released at once,
+    /// when the last `ValuePtr` to any value of the document is released.
+    ///
+    /// There are no changes in the interface: Every `ValuePtr` returned by a value of the document shares
+    /// the ownership of the whole document, so it can be used like a regular pointer. For fast access in
+    /// loops, you can use the raw `Value*` pointers from `ValuePtr::get()`, which stay valid as long as
+    /// one pointer to the document is held.
+    ///
+    /// @note Values that are removed from or replaced in the document stay in memory until the whole
+    ///     document is released.
+    ///
+    /// @param enabled `true` to enable the value arena.
+    ///
+    void setValueArenaEnabled(bool enabled) noexcept;
+
+    /// Set if the location ranges are stored in the parsed values.
+    ///
+    /// By default, every value stores the location range where it was defined in the document. If you do
+    /// not need the locations of the values, you can disable this to save time. The location range is stored
+    /// compactly in each value, so disabling it does not make the values smaller. In this case,
+    /// `Value::locationRange()` returns a range that is not set. Errors always report the location
+    /// where they occurred.
+    ///
+    /// @param enabled `false` to disable storing the location ranges.
+    ///
+    void setValueLocationsEnabled(bool enabled) noexcept;
+
+    /// Set if float, date and time values are converted on the first access.
+    ///
+    /// By default, the text of each value is converted while parsing. If you only read a small part of large
+    /// documents, you can enable lazy values. The syntax and the ranges of all values are still verified while
+    /// parsing, so the reported errors are the same. The text of float, date and time values is stored
+    /// in the value, and converted when the value is accessed for the first time. The converted value replaces
+    /// the text. Texts that are longer than 23 characters, like date/times with a time zone offset, are
+    /// converted immediately. Integers are always converted while parsing, to detect integers that do
+    /// not fit into 64 bits. The conversion is done once, also if multiple threads read the same document.
+    ///
+    /// @param enabled `true` to enable lazy values.
+    ///
+    void setLazyValuesEnabled(bool enabled) noexcept;
+
+    /// Set if files are mapped into memory for parsing.
+    ///
+    /// By default, `parseFileOrThrow()` reads files in blocks. If enabled, the file is mapped into memory
+    /// and the data is decoded directly from the mapping, without copying it. If the file cannot be mapped,
+    /// it is read in blocks.
+    ///
+    /// @warning Only enable this for files that are not modified while they are parsed. If another process
+    ///     truncates a mapped file, accessing the mapping can terminate the process (e.g. with `SIGBUS` on
+    ///     POSIX systems), instead of reporting an error.
+    ///
+    /// @param enabled `true` to map files into memory.
+    ///
+    void setFileMappingEnabled(bool enabled) noexcept;
+
+    /// Set if large documents are parsed in parallel.
+    ///
+    /// If enabled, large documents from files or data are split at the table headers into chunks, which
+    /// are parsed in parallel on the threads of the global `QThreadPool`. The chunks are merged into one
+    /// document, using the same rules for tables and arrays of tables as a sequential parse.
+    ///
+    /// The parallel parse is speculative: If a chunk contains an error, or the chunks can not be merged,
+    /// the document is parsed again sequentially. So the parsed document and the reported errors are the
+    /// same as without this option, only invalid documents take longer to parse.
+    ///
+    /// @note Documents that are smaller than 512 KiB, and documents from strings or custom streams are
+    ///     always parsed sequentially. Files are only parsed in parallel if file mapping is enabled with
+    ///     `setFileMappingEnabled()`, as the complete data must be in memory.
+    ///
+    /// @param enabled `true` to enable parallel parsing.
+    ///
+    void setParallelParsingEnabled(bool enabled) noexcept;
+
 public: // parse methods that throw exceptions.
     /// Parse TOML data from a string.
     ///
@@ -64,7 +143,8 @@ public: // parse methods that throw exceptions.
     /// Parse TOML data from a file.
     ///
     /// This function opens the file at `path` read-only, and reads the file as stream. It is the
-    /// most efficient way to read TOML data from a file.
+    /// most efficient way to read TOML data from a file. If file mapping is enabled with
+    /// `setFileMappingEnabled()`, the file is mapped into memory instead.
     ///
     /// @param path The absolute path to the file.
     /// @return A value that contains the parsed TOML data. This is always the special *root table*.
@@ -83,6 +163,46 @@ public: // parse methods that throw exceptions.
     ///
     [[nodiscard]] auto parseStreamOrThrow(const InputStreamPtr &inputStream) -> ValuePtr;
 
+public: // parse methods that send the contents to a handler.
+    /// Parse TOML data from a string and send its contents to a handler.
+    ///
+    /// The parser validates the document like the other parse methods, but does not build the tree of values.
+    /// Only the names of the keys are kept, to detect duplicate keys and invalid tables.
+    ///
+    /// @param str The string with the TOML data to parse.
+    /// @param handler The handler that receives the contents of the document.
+    /// @throws Error in case of any problem when parsing the data. The handler may already have received
+    ///     events for the statements before the error. Exceptions thrown by the handler are passed to the caller.
+    ///
+    void parseStringOrThrow(const QString &str, ParserHandler &handler);
+
+    /// Parse TOML data from UTF-8 encoded data and send its contents to a handler.
+    ///
+    /// @param data UTF-8 encoded data with TOML to parse.
+    /// @param handler The handler that receives the contents of the document.
+    /// @throws Error in case of any problem when parsing the data.
+    /// @see parseStringOrThrow(const QString&, ParserHandler&)
+    ///
+    void parseDataOrThrow(const QByteArray &data, ParserHandler &handler);
+
+    /// Parse TOML data from a file and send its contents to a handler.
+    ///
+    /// @param path The absolute path to the file.
+    /// @param handler The handler that receives the contents of the document.
+    /// @throws Error in case of any problem when parsing the data or reading the file.
+    /// @see parseStringOrThrow(const QString&, ParserHandler&)
+    ///
+    void parseFileOrThrow(const QString &path, ParserHandler &handler);
+
+    /// Parse TOML data from an input stream and send its contents to a handler.
+    ///
+    /// @param inputStream The input stream.
+    /// @param handler The handler that receives the contents of the document.
+    /// @throws Error from the stream implementation and on any problem with the data.
+    /// @see parseStringOrThrow(const QString&, ParserHandler&)
+    ///
+    void parseStreamOrThrow(const InputStreamPtr &inputStream, ParserHandler &handler);
+
 public: // parse methods that do not throw exceptions
     /// Parse TOML data from a string.
     ///
@@ -103,7 +223,8 @@ public: // parse methods that do not throw exceptions
     /// Parse TOML data from a file.
     ///
     /// This function opens the file at `path` read-only, and reads the file as stream. It is the
-    /// most efficient way to read TOML data from a file.
+    /// most efficient way to read TOML data from a file. If file mapping is enabled with
+    /// `setFileMappingEnabled()`, the file is mapped into memory instead.
     ///
     /// @param path The absolute path to the file.
     /// @return A value that contains the parsed TOML data, or a nullptr if there was an error.
@@ -128,6 +249,11 @@ public: // parse methods that do not throw exceptions
     ///
     [[nodiscard]] auto lastError() const noexcept -> const Error&;
 
+private:
+    /// Create the input stream for a file, as set with `setFileMappingEnabled()`.
+    ///
+    [[nodiscard]] auto createFileStreamOrThrow(const QString &path) const -> InputStreamPtr;
+
 private:
     impl::ParserData *d; ///< The implementation of the parser.
 };
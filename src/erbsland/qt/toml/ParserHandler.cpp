@@ -0,0 +1,50 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ParserHandler.hpp"
+
+
+namespace erbsland::qt::toml {
+
+
+ParserHandler::~ParserHandler() = default;
+
+
+void ParserHandler::onDocumentBegin() {
+}
+
+
+void ParserHandler::onDocumentEnd() {
+}
+
+
+void ParserHandler::onTable(const KeyPath &) {
+}
+
+
+void ParserHandler::onArrayOfTables(const KeyPath &) {
+}
+
+
+void ParserHandler::onKeyValue(const KeyPath &, const ValuePtr &) {
+}
+
+
+void ParserHandler::onArrayBegin(const KeyPath &) {
+}
+
+
+void ParserHandler::onArrayEnd(const KeyPath &) {
+}
+
+
+void ParserHandler::onInlineTableBegin(const KeyPath &) {
+}
+
+
+void ParserHandler::onInlineTableEnd(const KeyPath &) {
+}
+
+
+}
+
@@ -0,0 +1,99 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "KeyPath.hpp"
+#include "Namespace.hpp"
+#include "Value.hpp"
+
+
+namespace erbsland::qt::toml {
+
+
+/// The interface to receive the contents of a document as a sequence of events.
+///
+/// Pass a handler to one of the parse methods of `Parser`, to process a document without building
+/// the tree of values. The events are sent in document order, after each statement was validated. All
+/// paths start at the root of the document. In an array of tables, a path refers to the last table of
+/// the array, as in the TOML syntax.
+///
+/// Values in arrays and inline tables are reported between the begin and end events of their container.
+/// For a value in an array, the path is the path of the array.
+///
+/// @code
+/// class ImportHandler : public ParserHandler {
+/// public:
+///     void onKeyValue(const KeyPath &path, const ValuePtr &value) override {
+///         _database.insert(path.toString(), value->toVariant());
+///     }
+/// };
+/// @endcode
+///
+/// All methods have an empty default implementation, so you only implement the events you need.
+///
+class ParserHandler {
+    // fwd-entry: class ParserHandler
+
+public:
+    /// dtor
+    ///
+    virtual ~ParserHandler();
+
+public:
+    /// Called at the start of the document.
+    ///
+    virtual void onDocumentBegin();
+
+    /// Called after the last statement of the document.
+    ///
+    virtual void onDocumentEnd();
+
+    /// Called for a table header, like `[server.main]`.
+    ///
+    /// @param path The path of the table.
+    ///
+    virtual void onTable(const KeyPath &path);
+
+    /// Called for an array of tables header, like `[[server.alias]]`, that adds a new table to the array.
+    ///
+    /// @param path The path of the array.
+    ///
+    virtual void onArrayOfTables(const KeyPath &path);
+
+    /// Called for a value, that is no array or inline table.
+    ///
+    /// @param path The path of the value. For values in arrays, the path of the array.
+    /// @param value The value. The handler can keep it, the parser does not store it.
+    ///
+    virtual void onKeyValue(const KeyPath &path, const ValuePtr &value);
+
+    /// Called at the start of an array value.
+    ///
+    /// @param path The path of the array.
+    ///
+    virtual void onArrayBegin(const KeyPath &path);
+
+    /// Called at the end of an array value.
+    ///
+    /// @param path The path of the array.
+    ///
+    virtual void onArrayEnd(const KeyPath &path);
+
+    /// Called at the start of an inline table.
+    ///
+    /// @param path The path of the inline table. For an inline table in an array, the path of the array.
+    ///
+    virtual void onInlineTableBegin(const KeyPath &path);
+
+    /// Called at the end of an inline table.
+    ///
+    /// @param path The path of the inline table. For an inline table in an array, the path of the array.
+    ///
+    virtual void onInlineTableEnd(const KeyPath &path);
+};
+
+
+}
+
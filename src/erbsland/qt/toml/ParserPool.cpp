@@ -0,0 +1,121 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ParserPool.hpp"
+
+
+#include "Parser.hpp"
+
+#include "impl/WorkerGroup.hpp"
+
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThreadPool>
+
+#include <atomic>
+#include <exception>
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+ParserPool::ParserPool(Specification specification, QThreadPool *threadPool) noexcept
+    : _specification{specification},
+    _threadPool{threadPool != nullptr ? threadPool : QThreadPool::globalInstance()} {
+}
+
+
+ParserPool::~ParserPool() = default;
+
+
+void ParserPool::setValueArenaEnabled(bool enabled) noexcept {
+    QMutexLocker locker{&_mutex};
+    _isValueArenaEnabled = enabled;
+}
+
+
+void ParserPool::setValueLocationsEnabled(bool enabled) noexcept {
+    QMutexLocker locker{&_mutex};
+    _isValueLocationEnabled = enabled;
+}
+
+
+void ParserPool::setFileMappingEnabled(bool enabled) noexcept {
+    QMutexLocker locker{&_mutex};
+    _isFileMappingEnabled = enabled;
+}
+
+
+auto ParserPool::parseFiles(const QStringList &paths) noexcept -> ResultList {
+    return parseAll(static_cast<std::size_t>(paths.size()), [&paths](Parser &parser, std::size_t index) {
+        return parser.parseFileOrThrow(paths[static_cast<qsizetype>(index)]);
+    });
+}
+
+
+auto ParserPool::parseDataList(const QList<QByteArray> &dataList) noexcept -> ResultList {
+    return parseAll(static_cast<std::size_t>(dataList.size()), [&dataList](Parser &parser, std::size_t index) {
+        return parser.parseDataOrThrow(dataList[static_cast<qsizetype>(index)]);
+    });
+}
+
+
+auto ParserPool::parseStrings(const QStringList &strings) noexcept -> ResultList {
+    return parseAll(static_cast<std::size_t>(strings.size()), [&strings](Parser &parser, std::size_t index) {
+        return parser.parseStringOrThrow(strings[static_cast<qsizetype>(index)]);
+    });
+}
+
+
+auto ParserPool::parseStreams(const std::vector<InputStreamPtr> &inputStreams) noexcept -> ResultList {
+    return parseAll(inputStreams.size(), [&inputStreams](Parser &parser, std::size_t index) {
+        return parser.parseStreamOrThrow(inputStreams[index]);
+    });
+}
+
+
+auto ParserPool::parseAll(std::size_t count, const ParseFunction &parseFunction) noexcept -> ResultList {
+    ResultList results(count);
+    std::atomic<std::size_t> nextIndex{0};
+    impl::WorkerGroup::run(_threadPool, impl::WorkerGroup::workerCount(_threadPool, count), [&]() {
+        auto parser = acquireParser();
+        for (auto index = nextIndex++; index < count; index = nextIndex++) {
+            auto &result = results[index];
+            try {
+                result.value = parseFunction(*parser, index);
+            } catch (const Error &error) {
+                result.error = error;
+            } catch (const std::exception &exception) {
+                result.error = Error{QString::fromUtf8(exception.what())};
+            }
+        }
+        releaseParser(std::move(parser));
+    });
+    return results;
+}
+
+
+auto ParserPool::acquireParser() noexcept -> std::unique_ptr<Parser> {
+    QMutexLocker locker{&_mutex};
+    std::unique_ptr<Parser> parser;
+    if (_idleParsers.empty()) {
+        parser = std::make_unique<Parser>(_specification);
+    } else {
+        parser = std::move(_idleParsers.back());
+        _idleParsers.pop_back();
+    }
+    parser->setValueArenaEnabled(_isValueArenaEnabled);
+    parser->setValueLocationsEnabled(_isValueLocationEnabled);
+    parser->setFileMappingEnabled(_isFileMappingEnabled);
+    return parser;
+}
+
+
+void ParserPool::releaseParser(std::unique_ptr<Parser> parser) noexcept {
+    QMutexLocker locker{&_mutex};
+    _idleParsers.emplace_back(std::move(parser));
+}
+
+
+}
+
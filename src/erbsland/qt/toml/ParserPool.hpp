@@ -0,0 +1,169 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Error.hpp"
+#include "InputStream.hpp"
+#include "Namespace.hpp"
+#include "Specification.hpp"
+#include "Value.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+
+class QThreadPool;
+
+
+namespace erbsland::qt::toml {
+
+
+class Parser;
+
+
+/// A pool of parsers, to parse many independent documents in parallel.
+///
+/// The documents are parsed on the threads of a `QThreadPool`, and the calling thread is also used to parse
+/// documents. Each worker uses one parser for all documents it parses, and the parsers are kept in this pool
+/// to be reused by the next call. The results are returned in the order of the input.
+///
+/// @code
+/// ParserPool pool;
+/// const auto results = pool.parseFiles(paths);
+/// for (const auto &result : results) {
+///     if (result.value == nullptr) {
+///         qWarning() << result.error.toString();
+///     }
+/// }
+/// @endcode
+///
+/// @note You can call the parse methods of one pool from multiple threads at the same time.
+///
+class ParserPool final {
+    // fwd-entry: class ParserPool
+
+public:
+    /// The result for one parsed document.
+    ///
+    struct Result {
+        ValuePtr value; ///< The root table of the document, or `nullptr` if there was an error.
+        Error error; ///< The error, if `value` is `nullptr`.
+    };
+
+    /// A list of results.
+    ///
+    using ResultList = std::vector<Result>;
+
+public:
+    /// Create a new parser pool.
+    ///
+    /// @param specification The version of the specification to use for parsing.
+    /// @param threadPool The thread pool to use, or `nullptr` to use the global thread pool of the application.
+    ///     The thread pool must exist as long as this parser pool is used.
+    ///
+    explicit ParserPool(
+        Specification specification = Specification::Version_1_0,
+        QThreadPool *threadPool = nullptr) noexcept;
+
+    /// dtor
+    ///
+    ~ParserPool();
+
+    // no copy and assignment.
+    ParserPool(const ParserPool&) = delete;
+    auto operator=(const ParserPool&) = delete;
+
+public: // options
+    /// Set if the values of parsed documents are allocated in a value arena.
+    ///
+    /// @see Parser::setValueArenaEnabled()
+    ///
+    void setValueArenaEnabled(bool enabled) noexcept;
+
+    /// Set if the location ranges are stored in the parsed values.
+    ///
+    /// @see Parser::setValueLocationsEnabled()
+    ///
+    void setValueLocationsEnabled(bool enabled) noexcept;
+
+    /// Set if files are mapped into memory for parsing.
+    ///
+    /// @see Parser::setFileMappingEnabled()
+    ///
+    void setFileMappingEnabled(bool enabled) noexcept;
+
+public: // parse methods
+    /// Parse a list of files.
+    ///
+    /// @param paths The absolute paths to the files.
+    /// @return The results, in the same order as the paths.
+    ///
+    [[nodiscard]] auto parseFiles(const QStringList &paths) noexcept -> ResultList;
+
+    /// Parse a list of UTF-8 encoded documents.
+    ///
+    /// @param dataList The UTF-8 encoded documents.
+    /// @return The results, in the same order as the documents.
+    ///
+    [[nodiscard]] auto parseDataList(const QList<QByteArray> &dataList) noexcept -> ResultList;
+
+    /// Parse a list of documents from strings.
+    ///
+    /// @param strings The strings with the documents.
+    /// @return The results, in the same order as the strings.
+    ///
+    [[nodiscard]] auto parseStrings(const QStringList &strings) noexcept -> ResultList;
+
+    /// Parse a list of input streams.
+    ///
+    /// Each stream is read by one thread only, but the streams must not share any state that is not
+    /// thread-safe.
+    ///
+    /// @param inputStreams The input streams.
+    /// @return The results, in the same order as the streams.
+    ///
+    [[nodiscard]] auto parseStreams(const std::vector<InputStreamPtr> &inputStreams) noexcept -> ResultList;
+
+private:
+    /// The function to parse the document with the given index.
+    ///
+    using ParseFunction = std::function<ValuePtr(Parser&, std::size_t)>;
+
+    /// Parse a number of documents in parallel.
+    ///
+    /// @param count The number of documents.
+    /// @param parseFunction The function that parses one document, which throws on errors.
+    /// @return The results.
+    ///
+    auto parseAll(std::size_t count, const ParseFunction &parseFunction) noexcept -> ResultList;
+
+    /// Take an idle parser from this pool, or create a new one.
+    ///
+    auto acquireParser() noexcept -> std::unique_ptr<Parser>;
+
+    /// Return a parser to this pool.
+    ///
+    void releaseParser(std::unique_ptr<Parser> parser) noexcept;
+
+private:
+    Specification _specification; ///< The specification for all parsers.
+    QThreadPool *_threadPool; ///< The thread pool to use.
+    bool _isValueArenaEnabled{false}; ///< If the value arena is enabled.
+    bool _isValueLocationEnabled{true}; ///< If the value locations are stored.
+    bool _isFileMappingEnabled{false}; ///< If files are mapped into memory.
+    QMutex _mutex; ///< The mutex to protect the idle parsers.
+    std::vector<std::unique_ptr<Parser>> _idleParsers; ///< The parsers that can be reused.
+};
+
+
+}
+
@@ -0,0 +1,157 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "Snapshot.hpp"
+
+
+#include "Error.hpp"
+#include "Parser.hpp"
+
+#include "impl/DataInputStream.hpp"
+#include "impl/MappedFileInputStream.hpp"
+#include "impl/SnapshotData.hpp"
+#include "impl/SnapshotWriter.hpp"
+
+#include <QtCore/QFile>
+#include <QtCore/QSaveFile>
+
+#include <memory>
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+namespace {
+
+
+constexpr uint64_t cChecksumOffsetBasis = 0xcbf29ce484222325ULL; ///< The offset basis of the 64-bit FNV-1a checksum.
+constexpr uint64_t cChecksumPrime = 0x100000001b3ULL; ///< The prime of the 64-bit FNV-1a checksum.
+
+
+/// Map an open file into memory, or read it if it cannot be mapped.
+///
+/// Only use this for snapshot files, which are replaced atomically and never changed in place.
+///
+/// @param file The open file, that has to stay open while the data is used.
+/// @param path The path to the file for errors.
+/// @return The data of the file.
+/// @throws Error if the file cannot be read.
+///
+auto mapFileOrThrow(QFile &file, const QString &path) -> QByteArray {
+    uchar *mapping = nullptr;
+    if (file.size() > 0 && file.size() <= impl::MappedFileInputStream::cMaximumMappedSize) {
+        mapping = file.map(0, file.size());
+    }
+    if (mapping != nullptr) {
+        return QByteArray::fromRawData(reinterpret_cast<const char*>(mapping), static_cast<qsizetype>(file.size()));
+    }
+    auto data = file.readAll();
+    if (file.error() != QFileDevice::NoError) {
+        throw Error::createIO(path, file);
+    }
+    return data;
+}
+
+
+/// Calculate the checksum of a source document and the specification that is used to parse it.
+///
+/// The specification is added to the checksum like one more byte of the document, so a snapshot that
+/// was written for a different specification is out of date.
+///
+auto parsedSourceChecksum(const QByteArray &data, Specification specification) noexcept -> uint64_t {
+    auto result = Snapshot::sourceChecksum(data);
+    result ^= static_cast<uint8_t>(specification);
+    result *= cChecksumPrime;
+    return result;
+}
+
+
+}
+
+
+auto Snapshot::sourceChecksum(const QByteArray &data) noexcept -> uint64_t {
+    // 64-bit FNV-1a, which gives the same result on every system.
+    uint64_t result = cChecksumOffsetBasis;
+    for (const auto byte : data) {
+        result ^= static_cast<uint8_t>(byte);
+        result *= cChecksumPrime;
+    }
+    return result;
+}
+
+
+auto Snapshot::createData(const Value &root, uint64_t sourceChecksum) noexcept -> QByteArray {
+    impl::SnapshotWriter writer{sourceChecksum};
+    return writer.write(root);
+}
+
+
+void Snapshot::writeFileOrThrow(const QString &path, const Value &root, uint64_t sourceChecksum) {
+    const auto data = createData(root, sourceChecksum);
+    QSaveFile file{path};
+    if (!file.open(QIODevice::WriteOnly)) {
+        throw Error::createIO(path, file);
+    }
+    if (file.write(data) != data.size()) {
+        file.cancelWriting();
+        throw Error::createIO(path, file);
+    }
+    if (!file.commit()) {
+        throw Error::createIO(path, file);
+    }
+}
+
+
+auto Snapshot::loadDataOrThrow(const QByteArray &data, uint64_t sourceChecksum) -> ValuePtr {
+    const auto snapshotData = impl::SnapshotData::createOrThrow(data, nullptr, QString{}, sourceChecksum);
+    return snapshotData->createRootValue();
+}
+
+
+auto Snapshot::loadFileOrThrow(const QString &path, uint64_t sourceChecksum) -> ValuePtr {
+    auto file = std::make_unique<QFile>(path);
+    if (!file->open(QIODevice::ReadOnly)) {
+        throw Error::createIO(path, *file);
+    }
+    auto data = mapFileOrThrow(*file, path);
+    const auto snapshotData = impl::SnapshotData::createOrThrow(std::move(data), std::move(file), path, sourceChecksum);
+    return snapshotData->createRootValue();
+}
+
+
+auto Snapshot::loadOrParseFileOrThrow(
+    const QString &path,
+    const QString &snapshotPath,
+    Specification specification) -> ValuePtr {
+
+    QFile file{path};
+    if (!file.open(QIODevice::ReadOnly)) {
+        throw Error::createIO(path, file);
+    }
+    // The source file is not mapped into memory, as it may be changed while it is read.
+    const auto data = file.readAll();
+    if (file.error() != QFileDevice::NoError) {
+        throw Error::createIO(path, file);
+    }
+    const auto checksum = parsedSourceChecksum(data, specification);
+    if (QFile::exists(snapshotPath)) {
+        try {
+            return loadFileOrThrow(snapshotPath, checksum);
+        } catch (const Error&) {
+            // The snapshot is out of date or damaged, parse the document again.
+        }
+    }
+    Parser parser{specification};
+    auto document = parser.parseStreamOrThrow(std::make_shared<impl::DataInputStream>(data, path));
+    try {
+        writeFileOrThrow(snapshotPath, *document, checksum);
+    } catch (const Error&) {
+        // The snapshot is only a cache, the parsed document is still valid.
+    }
+    return document;
+}
+
+
+}
+
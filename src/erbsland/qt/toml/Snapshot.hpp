@@ -0,0 +1,114 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Namespace.hpp"
+#include "Specification.hpp"
+#include "Value.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+#include <cstdint>
+
+
+namespace erbsland::qt::toml {
+
+
+/// Functions to store parsed documents in a binary snapshot, and to load them again.
+///
+/// Loading a snapshot is much faster than parsing the document again. If a snapshot is loaded from a
+/// file, the file is mapped into memory and the tables and arrays are only read when they are accessed
+/// for the first time. Keys that are missing in a table are found using the sorted key index of the
+/// snapshot, without reading the table.
+///
+/// Each snapshot stores a checksum of the source document, to detect snapshots that are out of date.
+///
+/// @code
+/// // Parse the document, or load it from the snapshot if the document did not change.
+/// auto toml = Snapshot::loadOrParseFileOrThrow(path, path + QStringLiteral(".snapshot"));
+/// @endcode
+///
+/// @note Snapshots do not store the location ranges of the values. They are stored in the byte order of
+///     the system that wrote them, and a snapshot from a system with a different byte order is rejected.
+///
+class Snapshot final {
+    // fwd-entry: class Snapshot
+
+public:
+    // This class only provides static functions.
+    Snapshot() = delete;
+
+public:
+    /// Calculate the checksum of a source document.
+    ///
+    /// The checksum does not change between processes, systems or versions of this library.
+    ///
+    /// @param data The data of the source document.
+    /// @return The checksum.
+    ///
+    [[nodiscard]] static auto sourceChecksum(const QByteArray &data) noexcept -> uint64_t;
+
+    /// Create the snapshot data for a value tree.
+    ///
+    /// @param root The root value, usually the root table of a document.
+    /// @param sourceChecksum The checksum of the source document.
+    /// @return The snapshot data.
+    ///
+    [[nodiscard]] static auto createData(const Value &root, uint64_t sourceChecksum = 0) noexcept -> QByteArray;
+
+    /// Write the snapshot of a value tree into a file.
+    ///
+    /// The file is replaced atomically, so a process that reads the snapshot never sees a partial file.
+    ///
+    /// @param path The path to the snapshot file.
+    /// @param root The root value, usually the root table of a document.
+    /// @param sourceChecksum The checksum of the source document.
+    /// @throws Error if the file cannot be written.
+    ///
+    static void writeFileOrThrow(const QString &path, const Value &root, uint64_t sourceChecksum = 0);
+
+    /// Load a snapshot from data.
+    ///
+    /// @param data The snapshot data.
+    /// @param sourceChecksum The expected checksum of the source document.
+    /// @return The root table of the snapshot.
+    /// @throws Error if the data is no valid snapshot, or the checksum does not match.
+    ///
+    [[nodiscard]] static auto loadDataOrThrow(const QByteArray &data, uint64_t sourceChecksum = 0) -> ValuePtr;
+
+    /// Load a snapshot from a file.
+    ///
+    /// The file is mapped into memory and stays open, as long as values from the snapshot exist.
+    ///
+    /// @param path The path to the snapshot file.
+    /// @param sourceChecksum The expected checksum of the source document.
+    /// @return The root table of the snapshot.
+    /// @throws Error if the file cannot be read, is no valid snapshot, or the checksum does not match.
+    ///
+    [[nodiscard]] static auto loadFileOrThrow(const QString &path, uint64_t sourceChecksum = 0) -> ValuePtr;
+
+    /// Load a document from its snapshot, or parse it and write a new snapshot.
+    ///
+    /// If the snapshot is missing, invalid or out of date, the document is parsed and the snapshot is
+    /// written again. An error writing the snapshot is ignored. The checksum in the snapshot covers the
+    /// source document and the specification, so a snapshot that was written for a different specification
+    /// is out of date.
+    ///
+    /// @param path The path to the source document.
+    /// @param snapshotPath The path to the snapshot file.
+    /// @param specification The version of the specification to use for parsing.
+    /// @return The root table of the document.
+    /// @throws Error if the source document cannot be read or contains an error.
+    ///
+    [[nodiscard]] static auto loadOrParseFileOrThrow(
+        const QString &path,
+        const QString &snapshotPath,
+        Specification specification = Specification::Version_1_0) -> ValuePtr;
+};
+
+
+}
+
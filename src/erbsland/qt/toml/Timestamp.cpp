@@ -0,0 +1,133 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "Timestamp.hpp"
+
+
+#include <array>
+
+
+namespace erbsland::qt::toml {
+
+
+namespace {
+
+
+constexpr int64_t cNanosecondsPerMillisecond = INT64_C(1000000); ///< The number of nanoseconds in one millisecond.
+constexpr int64_t cNanosecondsPerSecond = INT64_C(1000000000); ///< The number of nanoseconds in one second.
+
+
+/// Append a number with a fixed count of up to nine digits, padded with leading zeros.
+///
+void appendDigits(QString &text, int64_t value, int count) noexcept {
+    std::array<QChar, 9> digits;
+    for (auto index = count - 1; index >= 0; --index) {
+        digits[static_cast<std::size_t>(index)] = QChar(static_cast<char16_t>(u'0' + value % 10));
+        value /= 10;
+    }
+    for (int index = 0; index < count; ++index) {
+        text.append(digits[static_cast<std::size_t>(index)]);
+    }
+}
+
+
+}
+
+
+auto Timestamp::toDate() const noexcept -> QDate {
+    if (!hasDate()) {
+        return {};
+    }
+    return QDate::fromJulianDay(_julianDay);
+}
+
+
+auto Timestamp::toTime() const noexcept -> QTime {
+    if (!hasTime()) {
+        return {};
+    }
+    return QTime::fromMSecsSinceStartOfDay(static_cast<int>(_nanosecondsOfDay / cNanosecondsPerMillisecond));
+}
+
+
+auto Timestamp::toDateTime() const noexcept -> QDateTime {
+    switch (_kind) {
+    case Kind::LocalDateTime:
+        return QDateTime{toDate(), toTime(), Qt::LocalTime};
+    case Kind::OffsetDateTime:
+        return QDateTime{toDate(), toTime(), (_offsetSeconds == 0) ? Qt::UTC : Qt::OffsetFromUTC, _offsetSeconds};
+    default:
+        return {};
+    }
+}
+
+
+auto Timestamp::toString() const noexcept -> QString {
+    QString result;
+    if (hasDate()) {
+        const auto date = toDate();
+        appendDigits(result, date.year(), 4);
+        result.append(QChar('-'));
+        appendDigits(result, date.month(), 2);
+        result.append(QChar('-'));
+        appendDigits(result, date.day(), 2);
+    }
+    if (hasTime()) {
+        if (hasDate()) {
+            result.append(QChar('T'));
+        }
+        const auto seconds = _nanosecondsOfDay / cNanosecondsPerSecond;
+        appendDigits(result, seconds / 3600, 2);
+        result.append(QChar(':'));
+        appendDigits(result, (seconds / 60) % 60, 2);
+        result.append(QChar(':'));
+        appendDigits(result, seconds % 60, 2);
+        auto fraction = _nanosecondsOfDay % cNanosecondsPerSecond;
+        if (fraction != 0) {
+            int digits = 9;
+            for (; fraction % 10 == 0; fraction /= 10) {
+                digits -= 1;
+            }
+            result.append(QChar('.'));
+            appendDigits(result, fraction, digits);
+        }
+    }
+    if (hasOffset()) {
+        if (_offsetSeconds == 0) {
+            result.append(QChar('Z'));
+        } else {
+            const auto offsetMinutes = ((_offsetSeconds < 0) ? -_offsetSeconds : _offsetSeconds) / 60;
+            result.append((_offsetSeconds < 0) ? QChar('-') : QChar('+'));
+            appendDigits(result, offsetMinutes / 60, 2);
+            result.append(QChar(':'));
+            appendDigits(result, offsetMinutes % 60, 2);
+        }
+    }
+    return result;
+}
+
+
+auto Timestamp::fromTime(QTime time) noexcept -> Timestamp {
+    const auto nanosecondsOfDay = time.isValid()
+        ? static_cast<int64_t>(time.msecsSinceStartOfDay()) * cNanosecondsPerMillisecond : cNoTime;
+    return Timestamp{Kind::LocalTime, cNoDate, nanosecondsOfDay};
+}
+
+
+auto Timestamp::fromDate(QDate date) noexcept -> Timestamp {
+    return Timestamp{Kind::LocalDate, date.isValid() ? date.toJulianDay() : cNoDate, cNoTime};
+}
+
+
+auto Timestamp::fromDateTime(const QDateTime &dateTime) noexcept -> Timestamp {
+    const auto julianDay = fromDate(dateTime.date())._julianDay;
+    const auto nanosecondsOfDay = fromTime(dateTime.time())._nanosecondsOfDay;
+    if (dateTime.timeSpec() == Qt::LocalTime) {
+        return Timestamp{Kind::LocalDateTime, julianDay, nanosecondsOfDay};
+    }
+    return Timestamp{Kind::OffsetDateTime, julianDay, nanosecondsOfDay, dateTime.offsetFromUtc()};
+}
+
+
+}
+
@@ -0,0 +1,216 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Namespace.hpp"
+
+#include <QtCore/QDate>
+#include <QtCore/QDateTime>
+#include <QtCore/QString>
+#include <QtCore/QTime>
+
+#include <cstdint>
+#include <limits>
+
+
+namespace erbsland::qt::toml {
+
+
+/// A local time, local date, local date/time or offset date/time with nanosecond precision.
+///
+/// The timestamp stores the date as Julian day and the time as nanoseconds since midnight. For offset
+/// date/times, the date and time are the local date and time at the offset. All four kinds of TOML dates
+/// and times share this compact type, that does not allocate memory. It is only converted into the Qt
+/// types if they are requested, and these are limited to millisecond precision.
+///
+class Timestamp final {
+    // fwd-entry: class Timestamp
+
+public:
+    /// The kind of date and time that is stored in a timestamp.
+    ///
+    enum class Kind : uint8_t {
+        LocalTime, ///< A time without a date and an offset.
+        LocalDate, ///< A date without a time and an offset.
+        LocalDateTime, ///< A date and time without an offset.
+        OffsetDateTime, ///< A date and time with an offset from UTC.
+    };
+
+    /// The Julian day, used if the timestamp has no valid date.
+    ///
+    static constexpr int64_t cNoDate = std::numeric_limits<int64_t>::min();
+
+    /// The nanoseconds since midnight, used if the timestamp has no valid time.
+    ///
+    static constexpr int64_t cNoTime = -1;
+
+    /// The number of nanoseconds in one day.
+    ///
+    static constexpr int64_t cNanosecondsPerDay = INT64_C(86400000000000);
+
+public:
+    /// Create a null timestamp.
+    ///
+    /// A null timestamp is a local time, without a valid date and time.
+    ///
+    constexpr Timestamp() noexcept = default;
+
+    /// Create a timestamp from its parts.
+    ///
+    /// @param kind The kind of the timestamp.
+    /// @param julianDay The date as Julian day, or `cNoDate` for a local time or an invalid date.
+    /// @param nanosecondsOfDay The time as nanoseconds since midnight, or `cNoTime` for a local date
+    ///     or an invalid time.
+    /// @param offsetSeconds The offset from UTC in seconds, only used for offset date/times.
+    ///
+    constexpr Timestamp(Kind kind, int64_t julianDay, int64_t nanosecondsOfDay, int32_t offsetSeconds = 0) noexcept
+        : _julianDay{julianDay}, _nanosecondsOfDay{nanosecondsOfDay}, _offsetSeconds{offsetSeconds}, _kind{kind} {
+    }
+
+    // defaults
+    /// @private
+    /// copy
+    Timestamp(const Timestamp&) = default;
+    /// @private
+    /// move
+    Timestamp(Timestamp&&) noexcept = default;
+    /// @private
+    /// assign
+    auto operator=(const Timestamp&) -> Timestamp& = default;
+    /// @private
+    /// move assign
+    auto operator=(Timestamp&&) noexcept -> Timestamp& = default;
+    /// @private
+    /// dtor
+    ~Timestamp() = default;
+
+public: // operators
+    /// Compare two timestamps.
+    ///
+    [[nodiscard]] constexpr auto operator==(const Timestamp &other) const noexcept -> bool {
+        return _kind == other._kind && _julianDay == other._julianDay
+            && _nanosecondsOfDay == other._nanosecondsOfDay && _offsetSeconds == other._offsetSeconds;
+    }
+    /// Compare two timestamps.
+    ///
+    [[nodiscard]] constexpr auto operator!=(const Timestamp &other) const noexcept -> bool {
+        return !operator==(other);
+    }
+
+public: // access
+    /// Get the kind of this timestamp.
+    ///
+    [[nodiscard]] constexpr auto kind() const noexcept -> Kind { return _kind; }
+
+    /// Test if this timestamp has neither a valid date nor a valid time.
+    ///
+    [[nodiscard]] constexpr auto isNull() const noexcept -> bool { return !hasDate() && !hasTime(); }
+
+    /// Test if this timestamp has a valid date.
+    ///
+    [[nodiscard]] constexpr auto hasDate() const noexcept -> bool { return _julianDay != cNoDate; }
+
+    /// Test if this timestamp has a valid time.
+    ///
+    [[nodiscard]] constexpr auto hasTime() const noexcept -> bool { return _nanosecondsOfDay >= 0; }
+
+    /// Test if this timestamp has an offset from UTC.
+    ///
+    [[nodiscard]] constexpr auto hasOffset() const noexcept -> bool { return _kind == Kind::OffsetDateTime; }
+
+    /// Get the date as Julian day.
+    ///
+    /// @return The Julian day, or `cNoDate` if this timestamp has no valid date.
+    ///
+    [[nodiscard]] constexpr auto julianDay() const noexcept -> int64_t { return _julianDay; }
+
+    /// Get the time as nanoseconds since midnight.
+    ///
+    /// @return The nanoseconds since midnight, or `cNoTime` if this timestamp has no valid time.
+    ///
+    [[nodiscard]] constexpr auto nanosecondsOfDay() const noexcept -> int64_t { return _nanosecondsOfDay; }
+
+    /// Get the fraction of the second in nanoseconds.
+    ///
+    /// @return The nanoseconds from 0 to 999'999'999, or zero if this timestamp has no valid time.
+    ///
+    [[nodiscard]] constexpr auto nanosecond() const noexcept -> int32_t {
+        return hasTime() ? static_cast<int32_t>(_nanosecondsOfDay % INT64_C(1000000000)) : 0;
+    }
+
+    /// Get the offset from UTC.
+    ///
+    /// @return The offset in seconds, or zero if this is no offset date/time.
+    ///
+    [[nodiscard]] constexpr auto offsetSeconds() const noexcept -> int32_t { return _offsetSeconds; }
+
+public: // conversion
+    /// Convert the date of this timestamp.
+    ///
+    /// @return The date, or QDate{} if this timestamp has no valid date.
+    ///
+    [[nodiscard]] auto toDate() const noexcept -> QDate;
+
+    /// Convert the time of this timestamp.
+    ///
+    /// The fraction of the second is truncated to milliseconds.
+    ///
+    /// @return The time, or QTime{} if this timestamp has no valid time.
+    ///
+    [[nodiscard]] auto toTime() const noexcept -> QTime;
+
+    /// Convert this timestamp into a date/time.
+    ///
+    /// The fraction of the second is truncated to milliseconds. Local date/times use `Qt::LocalTime`,
+    /// offset date/times use `Qt::UTC` or `Qt::OffsetFromUTC`.
+    ///
+    /// @return The date/time, or QDateTime{} if this is no local or offset date/time.
+    ///
+    [[nodiscard]] auto toDateTime() const noexcept -> QDateTime;
+
+    /// Convert this timestamp into its TOML text.
+    ///
+    /// The fraction of the second is written with all significant digits, up to nanoseconds.
+    ///
+    /// @return The text, like `1979-05-27T07:32:00.123456789-07:00`, or an empty string for a null timestamp.
+    ///
+    [[nodiscard]] auto toString() const noexcept -> QString;
+
+public: // factories
+    /// Create a local time timestamp.
+    ///
+    /// @param time The time.
+    /// @return The timestamp, with no valid time if `time` is not valid.
+    ///
+    [[nodiscard]] static auto fromTime(QTime time) noexcept -> Timestamp;
+
+    /// Create a local date timestamp.
+    ///
+    /// @param date The date.
+    /// @return The timestamp, with no valid date if `date` is not valid.
+    ///
+    [[nodiscard]] static auto fromDate(QDate date) noexcept -> Timestamp;
+
+    /// Create a local or offset date/time timestamp.
+    ///
+    /// Date/times with `Qt::LocalTime` are converted into local date/times, all other date/times into
+    /// offset date/times, with the offset of the date/time.
+    ///
+    /// @param dateTime The date/time.
+    /// @return The timestamp.
+    ///
+    [[nodiscard]] static auto fromDateTime(const QDateTime &dateTime) noexcept -> Timestamp;
+
+private:
+    // The members are ordered by size, to avoid padding.
+    int64_t _julianDay{cNoDate}; ///< The date as Julian day, or `cNoDate`.
+    int64_t _nanosecondsOfDay{cNoTime}; ///< The time as nanoseconds since midnight, or `cNoTime`.
+    int32_t _offsetSeconds{}; ///< The offset from UTC in seconds.
+    Kind _kind{Kind::LocalTime}; ///< The kind of this timestamp.
+};
+
+
+}
+
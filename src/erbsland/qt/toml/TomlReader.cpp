@@ -0,0 +1,123 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "TomlReader.hpp"
+
+
+#include "impl/ParserData.hpp"
+#include "impl/SectionBuilder.hpp"
+
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+TomlReader::TomlReader(Specification specification) noexcept
+    : d{new impl::ParserData{specification}}, _section{std::make_unique<impl::ReaderSection>()} {
+}
+
+
+TomlReader::~TomlReader() {
+    d->abortParse();
+    delete d;
+}
+
+
+void TomlReader::setValueLocationsEnabled(bool enabled) noexcept {
+    d->setValueLocationEnabled(enabled);
+}
+
+
+void TomlReader::startWithStream(const InputStreamPtr &inputStream) noexcept {
+    d->abortParse();
+    _builder.reset();
+    *_section = {};
+    _inputStream = inputStream;
+    _isReading = false;
+    _hasFailed = false;
+}
+
+
+auto TomlReader::readNextOrThrow() -> bool {
+    if (_hasFailed) {
+        throw d->lastError();
+    }
+    *_section = {}; // release the previous section.
+    try {
+        if (!_isReading) {
+            if (_inputStream == nullptr) {
+                return false;
+            }
+            _builder = std::make_unique<impl::SectionBuilder>();
+            d->beginReading(std::exchange(_inputStream, {}), *_builder);
+            _isReading = true;
+        }
+        while (d->readNextStatement()) {
+            if (_builder->takeCompletedSection(*_section)) {
+                if (_section->path.isEmpty() && _section->table->size() == 0) {
+                    continue; // skip an empty root section.
+                }
+                return true;
+            }
+        }
+    } catch (const Error&) {
+        _hasFailed = true;
+        _isReading = false;
+        _builder.reset();
+        *_section = {};
+        throw;
+    } catch (std::exception&) {
+        _isReading = false;
+        _builder.reset();
+        *_section = {};
+        throw;
+    }
+    // At the end of the document, the current section is the last one.
+    *_section = _builder->takeCurrentSection();
+    _builder.reset();
+    _isReading = false;
+    if (_section->table == nullptr || (_section->path.isEmpty() && _section->table->size() == 0)) {
+        *_section = {};
+        return false;
+    }
+    return true;
+}
+
+
+auto TomlReader::readNext() noexcept -> bool {
+    try {
+        return readNextOrThrow();
+    } catch (const Error &error) {
+        return false;
+    }
+}
+
+
+auto TomlReader::hasError() const noexcept -> bool {
+    return _hasFailed;
+}
+
+
+auto TomlReader::lastError() const noexcept -> const Error& {
+    return d->lastError();
+}
+
+
+auto TomlReader::path() const noexcept -> const KeyPath& {
+    return _section->path;
+}
+
+
+auto TomlReader::isArrayOfTables() const noexcept -> bool {
+    return _section->isArrayOfTables;
+}
+
+
+auto TomlReader::table() const noexcept -> ValuePtr {
+    return _section->table;
+}
+
+
+}
+
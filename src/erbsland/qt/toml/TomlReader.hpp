@@ -0,0 +1,138 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Error.hpp"
+#include "InputStream.hpp"
+#include "KeyPath.hpp"
+#include "Namespace.hpp"
+#include "Specification.hpp"
+#include "Value.hpp"
+
+#include <memory>
+
+
+namespace erbsland::qt::toml {
+
+
+namespace impl {
+class ParserData;
+class SectionBuilder;
+struct ReaderSection;
+}
+
+
+/// A reader that reads a document section by section.
+///
+/// A section is the part of a document that starts with a table header, like `[table]`, or with an
+/// array of tables header, like `[[array]]`. The first section contains the assignments before the first
+/// header. Each call to `readNext()` reads one section, so for an array of tables, you get one table of
+/// the array at a time. The reader only keeps the current section, and releases it when the next section
+/// is read. So even very large documents are processed with little memory.
+///
+/// @code
+/// TomlReader reader;
+/// reader.startWithStream(InputStream::createFromMappedFileOrThrow(path));
+/// while (reader.readNextOrThrow()) {
+///     if (reader.isArrayOfTables() && reader.path() == cRowPath) {
+///         importRow(reader.table());
+///     }
+/// }
+/// @endcode
+///
+/// The document is validated like it is by `Parser`. Only the names of the keys are kept, to detect
+/// duplicate keys and invalid table definitions.
+///
+class TomlReader final {
+    // fwd-entry: class TomlReader
+
+public:
+    /// Create a new reader.
+    ///
+    /// @param specification The version of the specification to use for parsing.
+    ///
+    explicit TomlReader(Specification specification = Specification::Version_1_0) noexcept;
+
+    /// dtor
+    ///
+    ~TomlReader();
+
+    // no copy and assignment.
+    TomlReader(const TomlReader&) = delete;
+    auto operator=(const TomlReader&) = delete;
+
+public:
+    /// Set if the location ranges are stored in the values.
+    ///
+    /// @see Parser::setValueLocationsEnabled()
+    ///
+    void setValueLocationsEnabled(bool enabled) noexcept;
+
+    /// Start reading a document from an input stream.
+    ///
+    /// Any document that was read before is discarded.
+    ///
+    /// @param inputStream The input stream.
+    ///
+    void startWithStream(const InputStreamPtr &inputStream) noexcept;
+
+    /// Read the next section of the document.
+    ///
+    /// The first section, with the assignments before the first header, is skipped if it is empty.
+    ///
+    /// @return `true` if a section was read, `false` at the end of the document.
+    /// @throws Error from the stream implementation and on any problem with the data. After an error, all
+    ///     calls to this method throw the same error, until a new document is started.
+    ///
+    [[nodiscard]] auto readNextOrThrow() -> bool;
+
+    /// Read the next section of the document.
+    ///
+    /// @return `true` if a section was read, `false` at the end of the document or if there was an error.
+    ///     Use `hasError()` and `lastError()` to test for an error.
+    ///
+    [[nodiscard]] auto readNext() noexcept -> bool;
+
+    /// Test if there was an error reading the document.
+    ///
+    [[nodiscard]] auto hasError() const noexcept -> bool;
+
+    /// Access the last error.
+    ///
+    [[nodiscard]] auto lastError() const noexcept -> const Error&;
+
+public: // the current section
+    /// Get the path of the header of the current section.
+    ///
+    /// @return The path of the table or the array of tables, or an empty path for the first section.
+    ///
+    [[nodiscard]] auto path() const noexcept -> const KeyPath&;
+
+    /// Test if the current section is a table of an array of tables.
+    ///
+    [[nodiscard]] auto isArrayOfTables() const noexcept -> bool;
+
+    /// Get the table of the current section.
+    ///
+    /// The table contains the values assigned in the section. Tables that are defined by later headers,
+    /// like `[table.sub]`, are separate sections and not part of this table. The table itself has no
+    /// location range.
+    ///
+    /// @return The table of the current section, or `nullptr` if there is no current section.
+    ///
+    [[nodiscard]] auto table() const noexcept -> ValuePtr;
+
+private:
+    impl::ParserData *d; ///< The implementation of the parser.
+    std::unique_ptr<impl::SectionBuilder> _builder; ///< The builder for the sections of the document.
+    std::unique_ptr<impl::ReaderSection> _section; ///< The current section.
+    InputStreamPtr _inputStream; ///< The input stream, until reading is started.
+    bool _isReading{false}; ///< If a document is read.
+    bool _hasFailed{false}; ///< If there was an error reading the document.
+};
+
+
+}
+
@@ -4,25 +4,50 @@
 #include "Value.hpp"
 
 
+#include "impl/ScalarConverter.hpp"
+#include "impl/SnapshotData.hpp"
+#include "impl/ValueArena.hpp"
+
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonValue>
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
 
+#include <algorithm>
 #include <utility>
 #include <exception>
+#include <iterator>
+#include <limits>
 
 
 namespace erbsland::qt::toml {
 
 
+namespace {
+
+
+/// Get the mutex for the conversion of lazy values.
+///
+/// Only the first access to a lazy value locks the mutex, all later accesses only test an atomic flag.
+///
+auto lazyStorageMutex() noexcept -> QMutex& {
+    static QMutex mutex;
+    return mutex;
+}
+
+
+}
+
+
 auto Value::size() const noexcept -> std::size_t {
     if (!isTable() && !isArray()) {
         return 0;
     }
-    if (auto ptr = std::get_if<TableValue>(&_storage); ptr != nullptr) {
+    if (auto ptr = tablePtr(); ptr != nullptr) {
         return ptr->size();
     }
-    if (auto ptr = std::get_if<ArrayValue>(&_storage); ptr != nullptr) {
+    if (auto ptr = arrayPtr(); ptr != nullptr) {
         return ptr->size();
     }
     return 0;
@@ -33,9 +58,9 @@ auto Value::value(std::size_t index) const noexcept -> ValuePtr {
     if (!isArray()) {
         return {};
     }
-    if (auto ptr = std::get_if<ArrayValue>(&_storage); ptr != nullptr) {
+    if (auto ptr = arrayPtr(); ptr != nullptr) {
         if (index < ptr->size()) {
-            return ptr->at(index);
+            return ownerPtr(ptr->at(index));
         }
     }
     return {};
@@ -47,38 +72,79 @@ auto Value::hasValue(const QString &keyPath) const noexcept -> bool {
 }
 
 
-auto Value::hasKey(const QString &key) const noexcept -> bool {
-    return valueFromKey(key) != nullptr;
+auto Value::hasValue(const KeyPath &keyPath) const noexcept -> bool {
+    return value(keyPath) != nullptr;
+}
+
+
+auto Value::hasKey(QStringView key) const noexcept -> bool {
+    if (!mayContainKey(key)) {
+        return false;
+    }
+    if (auto ptr = tablePtr(); ptr != nullptr) {
+        return ptr->contains(key);
+    }
+    return false;
 }
 
 
 auto Value::value(const QString &keyPath) const noexcept -> ValuePtr {
-    if (!isTable()) {
+    // Walk the key path using views, to not allocate a string for each key.
+    const auto path = QStringView{keyPath};
+    const Value *table = this;
+    qsizetype start = 0;
+    auto separator = path.indexOf(QChar('.'));
+    while (separator >= 0) {
+        table = table->valuePtrFromKey(path.mid(start, separator - start));
+        if (table == nullptr) {
+            return {};
+        }
+        start = separator + 1;
+        separator = path.indexOf(QChar('.'), start);
+    }
+    return table->valueFromKey(path.mid(start));
+}
+
+
+auto Value::value(const KeyPath &keyPath) const noexcept -> ValuePtr {
+    const auto &keys = keyPath.keys();
+    if (keys.isEmpty()) {
         return {};
     }
-    if (!keyPath.contains('.')) { // single key?
-        return valueFromKey(keyPath);
+    const Value *table = this;
+    const auto lastKey = std::prev(keys.end());
+    for (auto it = keys.begin(); it != lastKey; ++it) {
+        table = table->valuePtrFromKey(*it);
+        if (table == nullptr) {
+            return {};
+        }
+    }
+    return table->valueFromKey(*lastKey);
+}
+
+
+auto Value::valuePtrFromKey(QStringView key) const noexcept -> const Value* {
+    if (!mayContainKey(key)) {
+        return nullptr;
     }
-    auto frontKey = keyPath.section('.', 0, 0);
-    auto backKeys = keyPath.section('.', 1);
-    if (auto ptr = std::get_if<TableValue>(&_storage); ptr != nullptr) {
-        auto it = ptr->find(frontKey);
+    if (auto ptr = tablePtr(); ptr != nullptr) {
+        auto it = ptr->find(key);
         if (it != ptr->end()) {
-            return it->second->value(backKeys);
+            return it->second.get();
         }
     }
-    return {};
+    return nullptr;
 }
 
 
-auto Value::valueFromKey(const QString &key) const noexcept -> ValuePtr {
-    if (!isTable()) {
+auto Value::valueFromKey(QStringView key) const noexcept -> ValuePtr {
+    if (!isTable() || !mayContainKey(key)) {
         return {};
     }
-    if (auto ptr = std::get_if<TableValue>(&_storage); ptr != nullptr) {
+    if (auto ptr = tablePtr(); ptr != nullptr) {
         auto it = ptr->find(key);
         if (it != ptr->end()) {
-            return it->second;
+            return ownerPtr(it->second);
         }
     }
     return {};
@@ -92,8 +158,8 @@ void Value::addValue(const ValuePtr &value) noexcept {
     if (_source == Source::ExplicitTable && !value->isTable()) {
         return;
     }
-    if (auto ptr = std::get_if<ArrayValue>(&_storage); ptr != nullptr) {
-        ptr->emplace_back(value);
+    if (auto ptr = arrayPtr(); ptr != nullptr) {
+        ptr->emplace_back(linkPtr(value));
     }
 }
 
@@ -102,8 +168,8 @@ void Value::setValue(const QString &key, const ValuePtr &value) noexcept {
     if (!isTable()) {
         return;
     }
-    if (auto ptr = std::get_if<TableValue>(&_storage); ptr != nullptr) {
-        ptr->insert_or_assign(key, value);
+    if (auto ptr = tablePtr(); ptr != nullptr) {
+        ptr->insert_or_assign(key, linkPtr(value));
     }
 }
 
@@ -113,7 +179,7 @@ auto Value::tableKeys() const noexcept -> QStringList {
         return {};
     }
     QStringList result;
-    if (auto ptr = std::get_if<TableValue>(&_storage); ptr != nullptr) {
+    if (auto ptr = tablePtr(); ptr != nullptr) {
         for (const auto &entry : *ptr) {
             result.append(entry.first);
         }
@@ -127,10 +193,38 @@ auto Value::toValue(Type type) const noexcept -> T {
     if (_type != type) {
         return {};
     }
+    convertScalarText();
     return std::get<T>(_storage);
 }
 
 
+template<>
+auto Value::toValue<QTime>(Type type) const noexcept -> QTime {
+    if (_type != type) {
+        return {};
+    }
+    return toValue<Timestamp>(type).toTime();
+}
+
+
+template<>
+auto Value::toValue<QDate>(Type type) const noexcept -> QDate {
+    if (_type != type) {
+        return {};
+    }
+    return toValue<Timestamp>(type).toDate();
+}
+
+
+template<>
+auto Value::toValue<QDateTime>(Type type) const noexcept -> QDateTime {
+    if (_type != type) {
+        return {};
+    }
+    return toValue<Timestamp>(type).toDateTime();
+}
+
+
 auto Value::toInteger() const noexcept -> int64_t {
     return toValue<int64_t>(Type::Integer);
 }
@@ -166,13 +260,59 @@ auto Value::toDateTime() const noexcept -> QDateTime {
 }
 
 
+auto Value::toTimestamp() const noexcept -> Timestamp {
+    if (_type != Type::Time && _type != Type::Date && _type != Type::DateTime) {
+        return {};
+    }
+    return toValue<Timestamp>(_type);
+}
+
+
 auto Value::toTable() const noexcept -> TableValue {
-    return toValue<TableValue>(Type::Table);
+    const auto ptr = tablePtr();
+    if (ptr == nullptr) {
+        return {};
+    }
+    auto result = *ptr;
+    if (_arena != nullptr) {
+        for (auto &entry : result) {
+            entry.second = ownerPtr(entry.second);
+        }
+    }
+    return result;
 }
 
 
 auto Value::toArray() const noexcept -> ArrayValue {
-    return toValue<ArrayValue>(Type::Array);
+    const auto ptr = arrayPtr();
+    if (ptr == nullptr) {
+        return {};
+    }
+    auto result = *ptr;
+    if (_arena != nullptr) {
+        for (auto &value : result) {
+            value = ownerPtr(value);
+        }
+    }
+    return result;
+}
+
+
+auto Value::toStringView() const noexcept -> QStringView {
+    if (const auto str = std::get_if<QString>(&_storage); str != nullptr) {
+        return *str;
+    }
+    return {};
+}
+
+
+auto Value::toTableRef() const noexcept -> ValueTableRef {
+    return ValueTableRef{tableStorage()};
+}
+
+
+auto Value::toArrayRef() const noexcept -> ValueArrayRef {
+    return ValueArrayRef{arrayStorage()};
 }
 
 
@@ -197,17 +337,34 @@ auto Value::createString(QString value) noexcept -> ValuePtr {
 
 
 auto Value::createTime(QTime value) noexcept -> ValuePtr {
-    return std::make_shared<Value>(Type::Time, Source::Value, Storage{value}, PrivateTag{});
+    return createTimestamp(Timestamp::fromTime(value));
 }
 
 
 auto Value::createDate(QDate value) noexcept -> ValuePtr {
-    return std::make_shared<Value>(Type::Date, Source::Value, Storage{value}, PrivateTag{});
+    return createTimestamp(Timestamp::fromDate(value));
 }
 
 
 auto Value::createDateTime(QDateTime value) noexcept -> ValuePtr {
-    return std::make_shared<Value>(Type::DateTime, Source::Value, Storage{std::move(value)}, PrivateTag{});
+    return createTimestamp(Timestamp::fromDateTime(value));
+}
+
+
+auto Value::createTimestamp(Timestamp value) noexcept -> ValuePtr {
+    Type type;
+    switch (value.kind()) {
+    case Timestamp::Kind::LocalTime:
+        type = Type::Time;
+        break;
+    case Timestamp::Kind::LocalDate:
+        type = Type::Date;
+        break;
+    default:
+        type = Type::DateTime;
+        break;
+    }
+    return std::make_shared<Value>(type, Source::Value, Storage{value}, PrivateTag{});
 }
 
 
@@ -248,14 +405,14 @@ auto Value::toJson() const noexcept -> QJsonValue {
         return QJsonValue{toDateTime().toString(Qt::ISODateWithMs)};
     case Type::Table: {
         QJsonObject jsonObject;
-        for (const auto &[key, value] : toTable()) {
+        for (const auto &[key, value] : tableStorage()) {
             jsonObject[key] = value->toJson();
         }
         return jsonObject;
     }
     case Type::Array: {
         QJsonArray jsonArray;
-        for (const auto &value: toArray()) {
+        for (const auto &value: arrayStorage()) {
             jsonArray.append(value->toJson());
         }
         return jsonArray;
@@ -269,13 +426,13 @@ auto Value::toJson() const noexcept -> QJsonValue {
 auto Value::toVariant() const noexcept -> QVariant {
     if (type() == Type::Table) {
         QVariantMap variantMap;
-        for (const auto &[key, value] : toTable()) {
+        for (const auto &[key, value] : tableStorage()) {
             variantMap.insert(key, value->toVariant());
         }
         return variantMap;
     } else if (type() == Type::Array) {
         QVariantList variantList;
-        for (const auto &value: toArray()) {
+        for (const auto &value: arrayStorage()) {
             variantList.append(value->toVariant());
         }
         return variantList;
@@ -305,7 +462,7 @@ auto Value::toVariant() const noexcept -> QVariant {
 auto Value::toUnitTestJson() const noexcept -> QJsonValue {
     if (type() == Type::Table) {
         QJsonObject jsonObject;
-        for (const auto &[key, value] : toTable()) {
+        for (const auto &[key, value] : tableStorage()) {
             jsonObject[key] = value->toUnitTestJson();
         }
         return jsonObject;
@@ -313,7 +470,7 @@ auto Value::toUnitTestJson() const noexcept -> QJsonValue {
 
     if (type() == Type::Array) {
         QJsonArray jsonArray;
-        for (const auto &value: toArray()) {
+        for (const auto &value: arrayStorage()) {
             jsonArray.append(value->toUnitTestJson());
         }
         return jsonArray;
@@ -362,13 +519,13 @@ auto Value::toUnitTestJson() const noexcept -> QJsonValue {
 }
 
 
-template<typename T>
-auto Value::typeValue(ValueType type, const QString &keyPath, const T &defaultValue) const noexcept -> T {
+template<typename T, typename KeyPathT>
+auto Value::typeValue(ValueType type, const KeyPathT &keyPath, const T &defaultValue) const noexcept -> T {
     auto tableValue = value(keyPath);
     if (tableValue == nullptr || tableValue->type() != type) {
         return defaultValue;
     }
-    return std::get<T>(tableValue->_storage);
+    return tableValue->template toValue<T>(type);
 }
 
 
@@ -377,36 +534,71 @@ auto Value::stringValue(const QString &keyPath, const QString &defaultValue) con
 }
 
 
+auto Value::stringValue(const KeyPath &keyPath, const QString &defaultValue) const noexcept -> QString {
+    return typeValue<QString>(Type::String, keyPath, defaultValue);
+}
+
+
 auto Value::integerValue(const QString &keyPath, int64_t defaultValue) const noexcept -> int64_t {
     return typeValue<int64_t>(Type::Integer, keyPath, defaultValue);
 }
 
 
+auto Value::integerValue(const KeyPath &keyPath, int64_t defaultValue) const noexcept -> int64_t {
+    return typeValue<int64_t>(Type::Integer, keyPath, defaultValue);
+}
+
+
 auto Value::floatValue(const QString &keyPath, double defaultValue) const noexcept -> double {
     return typeValue<double>(Type::Float, keyPath, defaultValue);
 }
 
 
+auto Value::floatValue(const KeyPath &keyPath, double defaultValue) const noexcept -> double {
+    return typeValue<double>(Type::Float, keyPath, defaultValue);
+}
+
+
 auto Value::booleanValue(const QString &keyPath, bool defaultValue) const noexcept -> bool {
     return typeValue<bool>(Type::Boolean, keyPath, defaultValue);
 }
 
 
+auto Value::booleanValue(const KeyPath &keyPath, bool defaultValue) const noexcept -> bool {
+    return typeValue<bool>(Type::Boolean, keyPath, defaultValue);
+}
+
+
 auto Value::timeValue(const QString &keyPath, QTime defaultValue) const noexcept -> QTime {
     return typeValue<QTime>(Type::Time, keyPath, defaultValue);
 }
 
 
+auto Value::timeValue(const KeyPath &keyPath, QTime defaultValue) const noexcept -> QTime {
+    return typeValue<QTime>(Type::Time, keyPath, defaultValue);
+}
+
+
 auto Value::dateValue(const QString &keyPath, QDate defaultValue) const noexcept -> QDate {
     return typeValue<QDate>(Type::Date, keyPath, defaultValue);
 }
 
 
+auto Value::dateValue(const KeyPath &keyPath, QDate defaultValue) const noexcept -> QDate {
+    return typeValue<QDate>(Type::Date, keyPath, defaultValue);
+}
+
+
 auto Value::dateTimeValue(const QString &keyPath, const QDateTime& defaultValue) const noexcept -> QDateTime {
     return typeValue<QDateTime>(Type::DateTime, keyPath, defaultValue);
 }
 
 
+auto Value::dateTimeValue(const KeyPath &keyPath, const QDateTime& defaultValue) const noexcept -> QDateTime {
+    return typeValue<QDateTime>(Type::DateTime, keyPath, defaultValue);
+}
+
+
 auto Value::tableValue(const QString &keyPath) const noexcept -> ValuePtr {
     auto value = this->value(keyPath);
     if (value == nullptr || !value->isTable()) {
@@ -416,6 +608,15 @@ auto Value::tableValue(const QString &keyPath) const noexcept -> ValuePtr {
 }
 
 
+auto Value::tableValue(const KeyPath &keyPath) const noexcept -> ValuePtr {
+    auto value = this->value(keyPath);
+    if (value == nullptr || !value->isTable()) {
+        return createTable(Source::Value);
+    }
+    return value;
+}
+
+
 auto Value::arrayValue(const QString &keyPath) const noexcept -> ValuePtr {
     auto value = this->value(keyPath);
     if (value == nullptr || !value->isArray()) {
@@ -425,22 +626,33 @@ auto Value::arrayValue(const QString &keyPath) const noexcept -> ValuePtr {
 }
 
 
+auto Value::arrayValue(const KeyPath &keyPath) const noexcept -> ValuePtr {
+    auto value = this->value(keyPath);
+    if (value == nullptr || !value->isArray()) {
+        return createArray(Source::Value);
+    }
+    return value;
+}
+
+
 auto Value::clone() const noexcept -> ValuePtr {
     ValuePtr newValue;
     if (isTable()) {
         newValue = createTable(source());
-        for (const auto &[key, value] : toTable()) {
+        for (const auto &[key, value] : tableStorage()) {
             newValue->setValue(key, value->clone());
         }
     } else if (isArray()) {
         newValue = createArray(source());
-        for (const auto &value : toArray()) {
+        for (const auto &value : arrayStorage()) {
             newValue->addValue(value->clone());
         }
     } else {
-        newValue = std::make_shared<Value>(_type, _source, _storage, PrivateTag{});
+        newValue = std::make_shared<Value>(_type, _source, resolvedStorage(), PrivateTag{});
+    }
+    if (hasLocationRange()) {
+        newValue->setLocationRange(locationRange());
     }
-    newValue->setLocationRange(_locationRange);
     return newValue;
 }
 
@@ -449,7 +661,7 @@ auto Value::begin() noexcept -> ValueIterator {
     if (!isArray()) {
         return {};
     }
-    return {shared_from_this(), 0};
+    return {selfPtr(), 0};
 }
 
 
@@ -457,12 +669,252 @@ auto Value::end() noexcept -> ValueIterator {
     if (!isArray()) {
         return {};
     }
-    return {shared_from_this(), size()};
+    return {selfPtr(), size()};
+}
+
+
+auto Value::locationRange() const noexcept -> LocationRange {
+    switch (_locationStorage) {
+    case LocationStorage::Compact: {
+        const auto &compact = _locationData.compact;
+        const auto number = [&compact](std::size_t index) -> int64_t {
+            return static_cast<int64_t>(compact[index]) - 1;
+        };
+        return {{number(0), number(1), number(2)}, {number(3), number(4), number(5)}};
+    }
+    case LocationStorage::Owned:
+    case LocationStorage::Arena:
+        return *_locationData.range;
+    default:
+        return LocationRange::createNotSet();
+    }
 }
 
 
 void Value::setLocationRange(const LocationRange &locationRange) noexcept {
-    _locationRange = locationRange;
+    const std::array<int64_t, 6> numbers = {
+        locationRange.begin().index(), locationRange.begin().line(), locationRange.begin().column(),
+        locationRange.end().index(), locationRange.end().line(), locationRange.end().column()};
+    const auto fitsCompact = std::all_of(numbers.begin(), numbers.end(), [](int64_t number) -> bool {
+        return number >= -1 && number < static_cast<int64_t>(std::numeric_limits<uint32_t>::max());
+    });
+    if (fitsCompact) {
+        releaseLocationRange();
+        for (std::size_t i = 0; i < numbers.size(); ++i) {
+            _locationData.compact[i] = static_cast<uint32_t>(numbers[i] + 1);
+        }
+        _locationStorage = LocationStorage::Compact;
+        return;
+    }
+    if (_locationStorage != LocationStorage::Owned && _locationStorage != LocationStorage::Arena) {
+        if (_arena != nullptr) {
+            _locationData.range = _arena->allocateLocationRange();
+            _locationStorage = LocationStorage::Arena;
+        } else {
+            _locationData.range = new LocationRange{};
+            _locationStorage = LocationStorage::Owned;
+        }
+    }
+    *_locationData.range = locationRange;
+}
+
+
+Value::Value(const Value &other) noexcept
+    : std::enable_shared_from_this<Value>{},
+      _storage{other.resolvedStorage()},
+      _type{other._type},
+      _source{other._source} {
+    updateCopiedLinks();
+    if (other.hasLocationRange()) {
+        setLocationRange(other.locationRange());
+    }
+}
+
+
+auto Value::operator=(const Value &other) noexcept -> Value& {
+    if (this != &other) {
+        _storage = other.resolvedStorage();
+        _hasLazyStorage.store(false, std::memory_order_release);
+        _type = other._type;
+        _source = other._source;
+        updateCopiedLinks();
+        if (other.hasLocationRange()) {
+            setLocationRange(other.locationRange());
+        } else {
+            releaseLocationRange();
+        }
+    }
+    return *this;
+}
+
+
+Value::~Value() {
+    releaseLocationRange();
+}
+
+
+void Value::releaseLocationRange() noexcept {
+    if (_locationStorage == LocationStorage::Owned) {
+        delete _locationData.range;
+    }
+    _locationStorage = LocationStorage::None;
+}
+
+
+auto Value::resolvedStorage() const noexcept -> const Storage& {
+    convertScalarText();
+    loadSnapshotNode();
+    return _storage;
+}
+
+
+void Value::convertScalarText() const noexcept {
+    if (!_hasLazyStorage.load(std::memory_order_acquire)) {
+        return;
+    }
+    QMutexLocker locker{&lazyStorageMutex()};
+    const auto scalarText = std::get_if<ScalarText>(&_storage);
+    if (scalarText == nullptr) {
+        return; // converted by another thread, or a snapshot node.
+    }
+    std::array<QChar, ScalarText::cCapacity> characters;
+    for (std::size_t i = 0; i < scalarText->size; ++i) {
+        characters[i] = QChar(scalarText->text[i]);
+    }
+    const auto text = QStringView{characters.data(), static_cast<qsizetype>(scalarText->size)};
+    switch (_type) {
+    case Type::Float:
+        _storage = impl::ScalarConverter::toFloat(text);
+        break;
+    case Type::Time:
+    case Type::Date:
+    case Type::DateTime:
+        _storage = impl::ScalarConverter::toTimestamp(_type, text);
+        break;
+    default:
+        break; // only the types above are stored as text.
+    }
+    _hasLazyStorage.store(false, std::memory_order_release);
+}
+
+
+void Value::loadSnapshotNode() const noexcept {
+    // The copy keeps the snapshot, as storing the loaded level destroys the node.
+    SnapshotNode snapshotNode{};
+    if (!copySnapshotNode(snapshotNode)) {
+        return;
+    }
+    // Load the level outside the lock for all lazy values, and test again if another thread loaded it.
+    QMutexLocker loadLocker{&snapshotNode.data->loadMutex()};
+    if (!_hasLazyStorage.load(std::memory_order_acquire)) {
+        return;
+    }
+    Storage storage;
+    if (_type == Type::Table) {
+        storage = Box<TableValue>{snapshotNode.data->readTable(snapshotNode.offset)};
+    } else {
+        storage = Box<ArrayValue>{snapshotNode.data->readArray(snapshotNode.offset)};
+    }
+    QMutexLocker locker{&lazyStorageMutex()};
+    _storage = std::move(storage);
+    _hasLazyStorage.store(false, std::memory_order_release);
+}
+
+
+auto Value::copySnapshotNode(SnapshotNode &snapshotNode) const noexcept -> bool {
+    if (!_hasLazyStorage.load(std::memory_order_acquire)) {
+        return false;
+    }
+    QMutexLocker locker{&lazyStorageMutex()};
+    const auto node = std::get_if<SnapshotNode>(&_storage);
+    if (node == nullptr) {
+        return false; // loaded by another thread, or a scalar value.
+    }
+    snapshotNode = *node;
+    return true;
+}
+
+
+auto Value::mayContainKey(QStringView key) const noexcept -> bool {
+    SnapshotNode snapshotNode{};
+    if (copySnapshotNode(snapshotNode)) {
+        return snapshotNode.data->mayContainKey(snapshotNode.offset, key);
+    }
+    return true;
+}
+
+
+auto Value::tableStorage() const noexcept -> const TableValue& {
+    if (const auto ptr = tablePtr(); ptr != nullptr) {
+        return *ptr;
+    }
+    static const TableValue cEmptyTable{};
+    return cEmptyTable;
+}
+
+
+auto Value::arrayStorage() const noexcept -> const ArrayValue& {
+    if (const auto ptr = arrayPtr(); ptr != nullptr) {
+        return *ptr;
+    }
+    static const ArrayValue cEmptyArray{};
+    return cEmptyArray;
+}
+
+
+auto Value::tablePtr() const noexcept -> TableValue* {
+    loadSnapshotNode();
+    if (auto box = std::get_if<Box<TableValue>>(&_storage); box != nullptr) {
+        return box->get();
+    }
+    return nullptr;
+}
+
+
+auto Value::arrayPtr() const noexcept -> ArrayValue* {
+    loadSnapshotNode();
+    if (auto box = std::get_if<Box<ArrayValue>>(&_storage); box != nullptr) {
+        return box->get();
+    }
+    return nullptr;
+}
+
+
+auto Value::ownerPtr(const ValuePtr &value) noexcept -> ValuePtr {
+    if (value == nullptr || value->_arena == nullptr) {
+        return value;
+    }
+    return value->_arena->ownerPtr(value.get());
+}
+
+
+auto Value::linkPtr(const ValuePtr &value) const noexcept -> ValuePtr {
+    if (value != nullptr && _arena != nullptr && value->_arena == _arena) {
+        return impl::ValueArena::linkPtr(value);
+    }
+    return value;
+}
+
+
+void Value::updateCopiedLinks() noexcept {
+    if (auto tableBox = std::get_if<Box<TableValue>>(&_storage); tableBox != nullptr && tableBox->get() != nullptr) {
+        for (auto &entry : *tableBox->get()) {
+            entry.second = linkPtr(ownerPtr(entry.second));
+        }
+    }
+    if (auto arrayBox = std::get_if<Box<ArrayValue>>(&_storage); arrayBox != nullptr && arrayBox->get() != nullptr) {
+        for (auto &value : *arrayBox->get()) {
+            value = linkPtr(ownerPtr(value));
+        }
+    }
+}
+
+
+auto Value::selfPtr() noexcept -> ValuePtr {
+    if (_arena != nullptr) {
+        return _arena->ownerPtr(this);
+    }
+    return shared_from_this();
 }
 
 
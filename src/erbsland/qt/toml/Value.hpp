@@ -5,9 +5,14 @@
 
 
 #include "Namespace.hpp"
+#include "KeyPath.hpp"
 #include "LocationRange.hpp"
+#include "Timestamp.hpp"
+#include "ValueArrayRef.hpp"
 #include "ValueIterator.hpp"
 #include "ValueSource.hpp"
+#include "ValueTable.hpp"
+#include "ValueTableRef.hpp"
 #include "ValueType.hpp"
 
 #include <QtCore/QString>
@@ -15,10 +20,11 @@
 #include <QtCore/QDate>
 #include <QtCore/QDateTime>
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <variant>
 #include <cstdint>
-#include <unordered_map>
 
 
 class QJsonValue;
@@ -32,32 +38,123 @@ class Value;
 using ValuePtr = std::shared_ptr<Value>; ///< A shared pointer for the `Value` class.
 
 
+namespace impl {
+class ParallelParser;
+class SnapshotData;
+class SnapshotWriter;
+class ValueArena;
+}
+
+
 /// A value handled by the TOML parser or serializer.
 ///
 /// @note This value type is not protected against infinite recursion. The parser will always produce valid results,
 /// if a user is creating own value structure, they have to pay attention to this possibility.
 ///
+/// @note If the document was parsed with the value arena enabled (see `Parser::setValueArenaEnabled()`), all
+/// values of the document are owned by the document. In this case, every `ValuePtr` to one of its values keeps
+/// the whole document alive.
+///
 class Value final : public std::enable_shared_from_this<Value> {
     // fwd-entry: class Value
+    friend class ValueArrayRef;
     friend class ValueIterator;
+    friend class ValueTableRef;
+    friend class impl::ParallelParser;
+    friend class impl::SnapshotData;
+    friend class impl::SnapshotWriter;
+    friend class impl::ValueArena;
 
 public:
-    using TableValue = std::unordered_map<QString, ValuePtr>; ///< The storage type used for table values.
+    using TableValue = ValueTable; ///< The storage type used for table values.
     using ArrayValue = std::vector<ValuePtr>; ///< The storage type used for arrays.
 
 private:
+    /// A box that stores a large value outside of the value, to keep the size of all other values small.
+    ///
+    /// The box is copied deeply, like the value it contains. A moved-from box is empty.
+    ///
+    template<typename T>
+    class Box {
+    public:
+        Box(T value) : _value{std::make_unique<T>(std::move(value))} {} // NOLINT(*-explicit-constructor)
+        Box(const Box &other) : _value{other._value != nullptr ? std::make_unique<T>(*other._value) : nullptr} {}
+        Box(Box&&) noexcept = default;
+        auto operator=(const Box &other) -> Box& {
+            if (_value != nullptr && other._value != nullptr) {
+                *_value = *other._value;
+            } else if (this != &other) {
+                _value = (other._value != nullptr) ? std::make_unique<T>(*other._value) : nullptr;
+            }
+            return *this;
+        }
+        auto operator=(Box&&) noexcept -> Box& = default;
+        ~Box() = default;
+
+    public:
+        [[nodiscard]] inline auto get() const noexcept -> T* { return _value.get(); }
+
+    private:
+        std::unique_ptr<T> _value; ///< The boxed value.
+    };
+
+    /// The unconverted text of a scalar value, from a parser with lazy values.
+    ///
+    /// The text is stored in the value, to avoid a separate allocation. It is converted into the value
+    /// for the type on the first access.
+    ///
+    struct ScalarText {
+        static constexpr std::size_t cCapacity = 23; ///< The maximum number of characters.
+
+        std::array<char, cCapacity> text; ///< The ASCII text of the token.
+        uint8_t size; ///< The number of characters in the text.
+    };
+
+    /// A table or array of a snapshot, that is not loaded yet.
+    ///
+    /// The entries or values are loaded from the snapshot on the first access. Tables and arrays in the
+    /// loaded level are stored as snapshot nodes again.
+    ///
+    struct SnapshotNode {
+        std::shared_ptr<const impl::SnapshotData> data; ///< The snapshot.
+        uint64_t offset; ///< The offset of the node in the snapshot.
+    };
+
+    /// How the location range of a value is stored.
+    ///
+    enum class LocationStorage : uint8_t {
+        None, ///< No location range is set.
+        Compact, ///< The location range is stored in the value, see `LocationData::compact`.
+        Owned, ///< The location range is stored outside the value, and owned by the value.
+        Arena, ///< The location range is stored outside the value, and owned by the arena of the value.
+    };
+
+    /// The storage for the location range of a value.
+    ///
+    /// Almost all location ranges are stored in the value itself, to avoid a separate allocation. Each
+    /// number is stored with an offset of one, so a location that is not set fits as well. Only a range
+    /// with a number that does not fit into 32 bits is stored outside the value.
+    ///
+    union LocationData {
+        std::array<uint32_t, 6> compact; ///< The begin and end index, line and column, plus one.
+        LocationRange *range; ///< The location range stored outside the value.
+    };
+
     /// The variant used to store the values.
     ///
+    /// Tables and arrays are boxed, as these types are much larger than all other types. Dates and times
+    /// are stored as timestamps, and only converted into the Qt types on access.
+    ///
     using Storage = std::variant<
-        int64_t,     // 0, Integer
-        double,      // 1, Float
-        bool,        // 2, Boolean
-        QString,     // 3, String
-        QTime,       // 4, Time
-        QDate,       // 5, Date
-        QDateTime,   // 6, DateTime
-        TableValue,  // 7, Table
-        ArrayValue>; // 8, Array
+        int64_t,          // 0, Integer
+        double,           // 1, Float
+        bool,             // 2, Boolean
+        QString,          // 3, String
+        Timestamp,        // 4, Time, Date or DateTime
+        Box<TableValue>,  // 5, Table
+        Box<ArrayValue>,  // 6, Array
+        ScalarText,       // 7, Float, Time, Date or DateTime, that is not converted yet.
+        SnapshotNode>;    // 8, Table or Array, that is not loaded from a snapshot yet.
 
 public: // local enum names.
     using Type = ValueType; ///< A local name for the value type enumeration.
@@ -78,9 +175,7 @@ public: // access
 
     /// Get the location range.
     ///
-    [[nodiscard]] inline auto locationRange() const noexcept -> LocationRange {
-        return _locationRange;
-    }
+    [[nodiscard]] auto locationRange() const noexcept -> LocationRange;
 
     /// Get the size of a table or array.
     ///
@@ -102,6 +197,13 @@ public: // access
     ///
     [[nodiscard]] auto hasValue(const QString &keyPath) const noexcept -> bool;
 
+    /// Test if the value with a given key path exists in a table.
+    ///
+    /// @param keyPath The compiled key path.
+    /// @return `true` if a value with that key path exists, `false` otherwise.
+    ///
+    [[nodiscard]] auto hasValue(const KeyPath &keyPath) const noexcept -> bool;
+
     /// Access a value of a table using a key or key path.
     ///
     /// @param keyPath The key, or a key path in the form `key.key.key`.
@@ -109,12 +211,25 @@ public: // access
     ///
     [[nodiscard]] auto value(const QString &keyPath) const noexcept -> ValuePtr;
 
+    /// Access a value of a table using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path.
+    /// @return The value for the value, or a `nullptr` if the key path does not exist or is empty.
+    ///
+    [[nodiscard]] auto value(const KeyPath &keyPath) const noexcept -> ValuePtr;
+
     /// Test if this table has a given key.
     ///
     /// This method exists, if you have to work with keys that contain a dot so you can't use
     /// the `hasValue()` methods with key paths.
     ///
-    [[nodiscard]] auto hasKey(const QString &key) const noexcept -> bool;
+    [[nodiscard]] auto hasKey(QStringView key) const noexcept -> bool;
+
+    /// @copydoc hasKey(QStringView) const
+    ///
+    [[nodiscard]] inline auto hasKey(const QString &key) const noexcept -> bool {
+        return hasKey(QStringView{key});
+    }
 
     /// Access a value of this table, using a single key.
     ///
@@ -124,7 +239,13 @@ public: // access
     /// @param key A single key, that can contain the dot character.
     /// @return The value for the value, or a `nullptr` if the key does not exist.
     ///
-    [[nodiscard]] auto valueFromKey(const QString &key) const noexcept -> ValuePtr;
+    [[nodiscard]] auto valueFromKey(QStringView key) const noexcept -> ValuePtr;
+
+    /// @copydoc valueFromKey(QStringView) const
+    ///
+    [[nodiscard]] inline auto valueFromKey(const QString &key) const noexcept -> ValuePtr {
+        return valueFromKey(QStringView{key});
+    }
 
 public: // convenience access
     /// Access a string value using a key path.
@@ -135,6 +256,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto stringValue(const QString &keyPath, const QString &defaultValue = {}) const noexcept -> QString;
 
+    /// Access a string value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no string.
+    /// @return The string at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto stringValue(const KeyPath &keyPath, const QString &defaultValue = {}) const noexcept -> QString;
+
     /// Access an integer value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -143,6 +272,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto integerValue(const QString &keyPath, int64_t defaultValue = {}) const noexcept -> int64_t;
 
+    /// Access an integer value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no integer.
+    /// @return The integer at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto integerValue(const KeyPath &keyPath, int64_t defaultValue = {}) const noexcept -> int64_t;
+
     /// Access a float value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -151,6 +288,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto floatValue(const QString &keyPath, double defaultValue = {}) const noexcept -> double;
 
+    /// Access a float value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no float.
+    /// @return The float at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto floatValue(const KeyPath &keyPath, double defaultValue = {}) const noexcept -> double;
+
     /// Access a boolean value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -159,6 +304,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto booleanValue(const QString &keyPath, bool defaultValue = {}) const noexcept -> bool;
 
+    /// Access a boolean value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no boolean.
+    /// @return The boolean at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto booleanValue(const KeyPath &keyPath, bool defaultValue = {}) const noexcept -> bool;
+
     /// Access a time value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -167,6 +320,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto timeValue(const QString &keyPath, QTime defaultValue = {}) const noexcept -> QTime;
 
+    /// Access a time value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no time value.
+    /// @return The time value at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto timeValue(const KeyPath &keyPath, QTime defaultValue = {}) const noexcept -> QTime;
+
     /// Access a date value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -175,6 +336,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto dateValue(const QString &keyPath, QDate defaultValue = {}) const noexcept -> QDate;
 
+    /// Access a date value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no date value.
+    /// @return The date value at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto dateValue(const KeyPath &keyPath, QDate defaultValue = {}) const noexcept -> QDate;
+
     /// Access an date/time value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -183,6 +352,14 @@ public: // convenience access
     ///
     [[nodiscard]] auto dateTimeValue(const QString &keyPath, const QDateTime& defaultValue = {}) const noexcept -> QDateTime;
 
+    /// Access an date/time value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @param defaultValue The default value that is used if the key does not exist or is no date/time.
+    /// @return The date/time at the given key path, or the `defaultValue`.
+    ///
+    [[nodiscard]] auto dateTimeValue(const KeyPath &keyPath, const QDateTime& defaultValue = {}) const noexcept -> QDateTime;
+
     /// Access a table value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -190,6 +367,13 @@ public: // convenience access
     ///
     [[nodiscard]] auto tableValue(const QString &keyPath) const noexcept -> ValuePtr;
 
+    /// Access a table value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @return The table value at the given key path, or an empty unconnected table value.
+    ///
+    [[nodiscard]] auto tableValue(const KeyPath &keyPath) const noexcept -> ValuePtr;
+
     /// Access an array value using a key path.
     ///
     /// @param keyPath The key path to the value, each key separated with a dot. Like `key.key.key`.
@@ -197,10 +381,17 @@ public: // convenience access
     ///
     [[nodiscard]] auto arrayValue(const QString &keyPath) const noexcept -> ValuePtr;
 
+    /// Access an array value using a compiled key path.
+    ///
+    /// @param keyPath The compiled key path to the value.
+    /// @return The array value at the given key path, or an empty unconnected array value.
+    ///
+    [[nodiscard]] auto arrayValue(const KeyPath &keyPath) const noexcept -> ValuePtr;
+
     /// Get a list with all keys of a table.
     ///
-    /// @return An unsorted list with all keys in this table, or an empty list if this table is empty or
-    ///    this value is no table.
+    /// @return A list with all keys in this table, in the order of their definition, or an empty list if this
+    ///    table is empty or this value is no table.
     ///
     [[nodiscard]] auto tableKeys() const noexcept -> QStringList;
 
@@ -298,9 +489,20 @@ public: // conversion
     ///
     [[nodiscard]] auto toDateTime() const noexcept -> QDateTime;
 
-    /// Get an unordered map from this value.
+    /// Get a timestamp from this value.
+    ///
+    /// The timestamp keeps the fraction of the second with nanosecond precision, while the Qt types
+    /// are limited to milliseconds.
+    ///
+    /// @return The timestamp, if this value is of the `Type::Time`, `Type::Date` or `Type::DateTime`,
+    ///     otherwise Timestamp{}.
+    ///
+    [[nodiscard]] auto toTimestamp() const noexcept -> Timestamp;
+
+    /// Get a table from this value.
     ///
-    /// @return An unordered map if this value is `Type::Table`, otherwise an empty map.
+    /// @return The table with all entries in the order of their definition, if this value is `Type::Table`,
+    ///     otherwise an empty table.
     ///
     [[nodiscard]] auto toTable() const noexcept -> TableValue;
 
@@ -310,6 +512,33 @@ public: // conversion
     ///
     [[nodiscard]] auto toArray() const noexcept -> ArrayValue;
 
+    /// Get a view on the string of this value, without copying it.
+    ///
+    /// The view is valid as long as this value exists and is not modified.
+    ///
+    /// @return A view on the string, if this value is of the `Type::String`, otherwise an empty view.
+    ///
+    [[nodiscard]] auto toStringView() const noexcept -> QStringView;
+
+    /// Access the table of this value, without copying it.
+    ///
+    /// The view is valid as long as this value exists and is not modified. Each value in the view is
+    /// returned as a pointer that shares the ownership of the document, like from `valueFromKey()`.
+    ///
+    /// @return A view on the table with all entries in the order of their definition, if this value is
+    ///     `Type::Table`, otherwise a view on an empty table.
+    ///
+    [[nodiscard]] auto toTableRef() const noexcept -> ValueTableRef;
+
+    /// Access the array of this value, without copying it.
+    ///
+    /// The view is valid as long as this value exists and is not modified. Each value in the view is
+    /// returned as a pointer that shares the ownership of the document, like from `value()`.
+    ///
+    /// @return A view on the array, if this value is `Type::Array`, otherwise a view on an empty array.
+    ///
+    [[nodiscard]] auto toArrayRef() const noexcept -> ValueArrayRef;
+
     /// Convert this value to a matching QJsonValue
     ///
     /// All structures are converted as expected by the TOML specification. Values that cannot be represented in
@@ -392,6 +621,16 @@ public:
     ///
     static auto createDateTime(QDateTime value) noexcept -> ValuePtr;
 
+    /// Create a new time, date or date and time value from a timestamp.
+    ///
+    /// Local times create `Type::Time`, local dates create `Type::Date` and all date/times create
+    /// `Type::DateTime` values.
+    ///
+    /// @param value The timestamp of the new value.
+    /// @return A shared pointer to the new value.
+    ///
+    static auto createTimestamp(Timestamp value) noexcept -> ValuePtr;
+
     /// Create a new empty table value.
     ///
     /// @param source The source of this table.
@@ -420,9 +659,25 @@ public:
     /// @param value The value.
     ///
     inline Value(Type type, Source source, Storage value, Value::PrivateTag /*unused*/) noexcept
-        : _type{type}, _source{source}, _storage{std::move(value)} {
+        : _storage{std::move(value)}, _type{type}, _source{source},
+          _hasLazyStorage{
+              std::holds_alternative<ScalarText>(_storage) || std::holds_alternative<SnapshotNode>(_storage)} {
     }
 
+    /// Copy a value.
+    ///
+    /// The copy is a regular shared value, that does not belong to an arena.
+    ///
+    Value(const Value &other) noexcept;
+
+    /// Assign a value.
+    ///
+    auto operator=(const Value &other) noexcept -> Value&;
+
+    /// dtor
+    ///
+    ~Value();
+
 private:
     /// Get the given type or the default value.
     ///
@@ -432,19 +687,117 @@ private:
     /// Return the value at the given key path if it exists and if it matches the type.
     ///
     /// @tparam Type The expected type.
+    /// @tparam KeyPathT The type of the key path, either `QString` or `KeyPath`.
     /// @param type The expected type enum.
-    /// @param keyPath The key path in the form `key.key.key`
+    /// @param keyPath The key path in the form `key.key.key`, or a compiled key path.
     /// @param defaultValue The default value returned if the key is not found or the type does not match.
     /// @return The value or `defaultValue`.
     ///
-    template<typename T>
-    auto typeValue(Type type, const QString &keyPath, const T &defaultValue) const noexcept -> T;
+    template<typename T, typename KeyPathT>
+    auto typeValue(Type type, const KeyPathT &keyPath, const T &defaultValue) const noexcept -> T;
+
+    /// Access a value of this table, without sharing the ownership.
+    ///
+    /// @param key A single key.
+    /// @return A pointer to the value, or `nullptr` if this is no table or the key does not exist.
+    ///
+    [[nodiscard]] auto valuePtrFromKey(QStringView key) const noexcept -> const Value*;
+
+    /// Get a pointer to a value from a table or array, that can be passed to the caller.
+    ///
+    /// Links between values of the same arena are not owning, so they are converted into pointers that
+    /// share the ownership of the arena.
+    ///
+    [[nodiscard]] static auto ownerPtr(const ValuePtr &value) noexcept -> ValuePtr;
+
+    /// Get a pointer to a value, that can be stored in this table or array.
+    ///
+    /// If the value is part of the same arena as this value, a non-owning link is returned.
+    ///
+    [[nodiscard]] auto linkPtr(const ValuePtr &value) const noexcept -> ValuePtr;
+
+    /// Get a shared pointer to this value.
+    ///
+    [[nodiscard]] auto selfPtr() noexcept -> ValuePtr;
+
+    /// Update the links to the values of a copied table or array.
+    ///
+    /// The copied links to values of an arena are not owning. They are converted into pointers that
+    /// share the ownership of the arena, unless the values are part of the same arena as this value.
+    ///
+    void updateCopiedLinks() noexcept;
+
+    /// Access the stored table, without converting the links to the values.
+    ///
+    /// @return The table, or an empty table if this is no table.
+    ///
+    [[nodiscard]] auto tableStorage() const noexcept -> const TableValue&;
+
+    /// Access the stored array, without converting the links to the values.
+    ///
+    /// @return The array, or an empty array if this is no array.
+    ///
+    [[nodiscard]] auto arrayStorage() const noexcept -> const ArrayValue&;
+
+    /// Access the table storage.
+    ///
+    /// @return A pointer to the table, or `nullptr` if this is no table.
+    ///
+    [[nodiscard]] auto tablePtr() const noexcept -> TableValue*;
+
+    /// Access the array storage.
+    ///
+    /// @return A pointer to the array, or `nullptr` if this is no array.
+    ///
+    [[nodiscard]] auto arrayPtr() const noexcept -> ArrayValue*;
+
+    /// Test if a location range is set for this value.
+    ///
+    [[nodiscard]] inline auto hasLocationRange() const noexcept -> bool {
+        return _locationStorage != LocationStorage::None;
+    }
+
+    /// Release the location range, if it is owned by this value.
+    ///
+    void releaseLocationRange() noexcept;
+
+    /// Get the storage, after converting or loading a lazy value.
+    ///
+    [[nodiscard]] auto resolvedStorage() const noexcept -> const Storage&;
+
+    /// Convert the text of a lazy scalar value into the value for its type, if not done yet.
+    ///
+    /// The conversion is done once, even if multiple threads access the value at the same time.
+    ///
+    void convertScalarText() const noexcept;
+
+    /// Load the entries or values of a table or array from its snapshot, if not done yet.
+    ///
+    /// The node is loaded once, even if multiple threads access the value at the same time.
+    ///
+    void loadSnapshotNode() const noexcept;
+
+    /// Get a copy of the snapshot node, if the table or array is not loaded yet.
+    ///
+    /// @return `true` if the node was copied, `false` if the storage is no snapshot node.
+    ///
+    [[nodiscard]] auto copySnapshotNode(SnapshotNode &snapshotNode) const noexcept -> bool;
+
+    /// Test if this table may contain a key, without loading it from a snapshot.
+    ///
+    /// @return `false` if this is a table of a snapshot that does not contain the key, otherwise `true`.
+    ///
+    [[nodiscard]] auto mayContainKey(QStringView key) const noexcept -> bool;
 
 private:
+    // The members are ordered by size, to avoid padding.
+    mutable Storage _storage; ///< The storage for this value. Mutable to convert lazy values on the first access.
+    LocationData _locationData{}; ///< The location range, stored as given by `_locationStorage`.
+    impl::ValueArena *_arena{}; ///< The arena that owns this value, or `nullptr` for a regular shared value.
     Type _type; ///< The type for this value.
     Source _source; ///< The source for this value.
-    LocationRange _locationRange{LocationRange::createNotSet()}; ///< The location range for this value.
-    Storage _storage; ///< The storage for this value.
+    LocationStorage _locationStorage{LocationStorage::None}; ///< How the location range is stored.
+    mutable std::atomic<bool> _hasLazyStorage{false}; ///< If the storage is not converted or loaded yet.
 };
 
 
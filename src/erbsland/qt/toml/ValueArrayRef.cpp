@@ -0,0 +1,29 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ValueArrayRef.hpp"
+
+
+#include "Value.hpp"
+
+
+namespace erbsland::qt::toml {
+
+
+auto ValueArrayRef::Iterator::operator*() const noexcept -> reference {
+    return ownerPtr(*_it);
+}
+
+
+auto ValueArrayRef::operator[](size_type index) const noexcept -> ValuePtr {
+    return ownerPtr((*_values)[index]);
+}
+
+
+auto ValueArrayRef::ownerPtr(const ValuePtr &value) noexcept -> ValuePtr {
+    return Value::ownerPtr(value);
+}
+
+
+}
+
@@ -0,0 +1,131 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+
+namespace erbsland::qt::toml {
+
+
+class Value;
+using ValuePtr = std::shared_ptr<Value>;
+
+
+/// A view on the values of an array value, without copying the array.
+///
+/// The view is returned by `Value::toArrayRef()`. Each value is returned as a pointer that shares the
+/// ownership of the document, so you can keep copies of it, also if the document was parsed with the
+/// value arena enabled.
+///
+/// ```cpp
+/// for (const auto &value : array->toArrayRef()) {
+///     // ...
+/// }
+/// ```
+///
+/// The view is valid as long as the array value exists and is not modified.
+///
+class ValueArrayRef final {
+    // fwd-entry: class ValueArrayRef
+    friend class Value;
+
+public:
+    /// The iterator over the values of the array.
+    ///
+    class Iterator final {
+        friend class ValueArrayRef;
+
+    public: // definitions to satisfy the iterator concept.
+        /// @private
+        using iterator_category = std::forward_iterator_tag;
+        /// @private
+        using value_type = ValuePtr;
+        /// @private
+        using difference_type = std::ptrdiff_t;
+        /// @private
+        using pointer = void;
+        /// @private
+        using reference = ValuePtr;
+
+    public:
+        /// Create an iterator that does not point to an array.
+        ///
+        Iterator() noexcept = default;
+
+    private:
+        /// Create an iterator from an iterator of the stored array.
+        ///
+        explicit Iterator(std::vector<ValuePtr>::const_iterator it) noexcept : _it{it} {}
+
+    public: // operators
+        /// Access the value.
+        ///
+        [[nodiscard]] auto operator*() const noexcept -> reference;
+
+        /// Increment the iterator.
+        ///
+        inline auto operator++() noexcept -> Iterator& { ++_it; return *this; }
+
+        /// Increment the iterator.
+        ///
+        inline auto operator++(int) noexcept -> Iterator { auto result = *this; ++_it; return result; }
+
+        /// Compare two iterators.
+        ///
+        [[nodiscard]] inline auto operator==(const Iterator &other) const noexcept -> bool { return _it == other._it; }
+
+        /// Compare two iterators.
+        ///
+        [[nodiscard]] inline auto operator!=(const Iterator &other) const noexcept -> bool { return _it != other._it; }
+
+    private:
+        std::vector<ValuePtr>::const_iterator _it{}; ///< The iterator of the stored array.
+    };
+
+    using iterator = Iterator; ///< The iterator.
+    using const_iterator = Iterator; ///< The constant iterator.
+    using size_type = std::size_t; ///< The size type.
+
+private:
+    /// Create a view on a stored array.
+    ///
+    explicit ValueArrayRef(const std::vector<ValuePtr> &values) noexcept : _values{&values} {}
+
+public: // iterators
+    [[nodiscard]] inline auto begin() const noexcept -> Iterator { return Iterator{_values->begin()}; }
+    [[nodiscard]] inline auto end() const noexcept -> Iterator { return Iterator{_values->end()}; }
+
+public: // access
+    /// Get the number of values.
+    ///
+    [[nodiscard]] inline auto size() const noexcept -> size_type { return _values->size(); }
+
+    /// Test if the array is empty.
+    ///
+    [[nodiscard]] inline auto empty() const noexcept -> bool { return _values->empty(); }
+
+    /// Access a value.
+    ///
+    /// @param index The index of the value, which must be less than `size()`.
+    /// @return A pointer to the value.
+    ///
+    [[nodiscard]] auto operator[](size_type index) const noexcept -> ValuePtr;
+
+private:
+    /// Convert a stored pointer into a pointer that shares the ownership of the document.
+    ///
+    [[nodiscard]] static auto ownerPtr(const ValuePtr &value) noexcept -> ValuePtr;
+
+private:
+    const std::vector<ValuePtr> *_values; ///< The stored array.
+};
+
+
+}
+
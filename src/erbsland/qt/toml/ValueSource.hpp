@@ -8,13 +8,15 @@
 
 #include <QtCore/QString>
 
+#include <cstdint>
+
 
 namespace erbsland::qt::toml {
 
 
 /// The source that defined the value.
 ///
-enum class ValueSource {
+enum class ValueSource : uint8_t {
     ImplicitTable, ///< Implicit key of a table `[this.this.key]`
     ExplicitTable, ///< Explicit key of a table `[key.key.this]`
     ImplicitValue, ///< Implicit key of a value `this.key.name = 5`
@@ -0,0 +1,199 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ValueTable.hpp"
+
+
+#include <QtCore/QHash>
+
+
+namespace erbsland::qt::toml {
+
+
+auto ValueTable::operator=(const ValueTable &other) -> ValueTable& {
+    if (this != &other) {
+        // The entries have constant keys and cannot be assigned, so the whole vector is replaced.
+        auto copy = other;
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+
+auto ValueTable::find(QStringView key) noexcept -> iterator {
+    return _entries.begin() + static_cast<std::ptrdiff_t>(indexOf(key));
+}
+
+
+auto ValueTable::find(QStringView key) const noexcept -> const_iterator {
+    return _entries.begin() + static_cast<std::ptrdiff_t>(indexOf(key));
+}
+
+
+auto ValueTable::count(QStringView key) const noexcept -> size_type {
+    return contains(key) ? 1 : 0;
+}
+
+
+auto ValueTable::contains(QStringView key) const noexcept -> bool {
+    return indexOf(key) < _entries.size();
+}
+
+
+auto ValueTable::at(QStringView key) -> mapped_type& {
+    const auto index = indexOf(key);
+    if (index >= _entries.size()) {
+        throw std::out_of_range{"No entry with this key in the table."};
+    }
+    return _entries[index].second;
+}
+
+
+auto ValueTable::at(QStringView key) const -> const mapped_type& {
+    const auto index = indexOf(key);
+    if (index >= _entries.size()) {
+        throw std::out_of_range{"No entry with this key in the table."};
+    }
+    return _entries[index].second;
+}
+
+
+auto ValueTable::operator[](const QString &key) -> mapped_type& {
+    const auto index = indexOf(key);
+    if (index < _entries.size()) {
+        return _entries[index].second;
+    }
+    return appendEntry(value_type{key, ValuePtr{}})->second;
+}
+
+
+auto ValueTable::insert(value_type entry) -> std::pair<iterator, bool> {
+    const auto index = indexOf(entry.first);
+    if (index < _entries.size()) {
+        return {_entries.begin() + static_cast<std::ptrdiff_t>(index), false};
+    }
+    return {appendEntry(std::move(entry)), true};
+}
+
+
+auto ValueTable::insert_or_assign(const QString &key, ValuePtr value) -> std::pair<iterator, bool> {
+    const auto index = indexOf(key);
+    if (index < _entries.size()) {
+        _entries[index].second = std::move(value);
+        return {_entries.begin() + static_cast<std::ptrdiff_t>(index), false};
+    }
+    return {appendEntry(value_type{key, std::move(value)}), true};
+}
+
+
+auto ValueTable::erase(QStringView key) -> size_type {
+    const auto index = indexOf(key);
+    if (index >= _entries.size()) {
+        return 0;
+    }
+    removeEntry(index);
+    return 1;
+}
+
+
+auto ValueTable::erase(const_iterator position) -> iterator {
+    const auto index = static_cast<std::size_t>(position - _entries.cbegin());
+    removeEntry(index);
+    return _entries.begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+
+void ValueTable::clear() noexcept {
+    _entries.clear();
+    _slots.clear();
+}
+
+
+void ValueTable::reserve(size_type size) {
+    _entries.reserve(size);
+}
+
+
+auto ValueTable::appendEntry(value_type entry) -> iterator {
+    _entries.emplace_back(std::move(entry));
+    if (_slots.empty()) {
+        if (_entries.size() > cLinearSearchLimit) {
+            rebuildIndex();
+        }
+    } else if (_entries.size() * 2 > _slots.size()) {
+        rebuildIndex(); // keep the load factor of the index below 0.5
+    } else {
+        addToIndex(_entries.size() - 1);
+    }
+    return _entries.end() - 1;
+}
+
+
+void ValueTable::removeEntry(std::size_t index) {
+    // The entries have constant keys and cannot be assigned, so the remaining entries are moved
+    // into a new vector.
+    std::vector<value_type> entries;
+    entries.reserve(_entries.capacity());
+    for (std::size_t i = 0; i < _entries.size(); ++i) {
+        if (i != index) {
+            entries.emplace_back(std::move(_entries[i]));
+        }
+    }
+    _entries = std::move(entries);
+    rebuildIndex(); // the indexes of all following entries changed.
+}
+
+
+auto ValueTable::indexOf(QStringView key) const noexcept -> std::size_t {
+    if (_slots.empty()) {
+        for (std::size_t i = 0; i < _entries.size(); ++i) {
+            if (isSameKey(_entries[i].first, key)) {
+                return i;
+            }
+        }
+        return _entries.size();
+    }
+    const auto mask = _slots.size() - 1;
+    for (auto slot = hashKey(key) & mask; _slots[slot] != 0; slot = (slot + 1) & mask) {
+        const auto index = static_cast<std::size_t>(_slots[slot] - 1);
+        if (isSameKey(_entries[index].first, key)) {
+            return index;
+        }
+    }
+    return _entries.size();
+}
+
+
+auto ValueTable::hashKey(QStringView key) noexcept -> std::size_t {
+    return static_cast<std::size_t>(qHash(key));
+}
+
+
+void ValueTable::addToIndex(std::size_t entryIndex) noexcept {
+    const auto mask = _slots.size() - 1;
+    auto slot = hashKey(_entries[entryIndex].first) & mask;
+    while (_slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    _slots[slot] = static_cast<uint32_t>(entryIndex + 1);
+}
+
+
+void ValueTable::rebuildIndex() {
+    _slots.clear();
+    if (_entries.size() <= cLinearSearchLimit) {
+        return;
+    }
+    std::size_t slotCount = 64;
+    while (slotCount < _entries.size() * 4) {
+        slotCount *= 2;
+    }
+    _slots.resize(slotCount, 0);
+    for (std::size_t i = 0; i < _entries.size(); ++i) {
+        addToIndex(i);
+    }
+}
+
+
+}
+
@@ -0,0 +1,256 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "Namespace.hpp"
+
+#include <QtCore/QString>
+#include <QtCore/QStringView>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+
+namespace erbsland::qt::toml {
+
+
+class Value;
+using ValuePtr = std::shared_ptr<Value>;
+
+
+/// The storage for the entries of a table value.
+///
+/// The entries are stored in a flat vector, in the order they were inserted. Small tables are searched
+/// linearly, which is faster than hashing for the few keys most tables have. For larger tables, an
+/// open-addressing hash index is built over the entries.
+///
+/// The interface follows the one of `std::unordered_map`, so iterating over the entries works as before:
+///
+/// ```cpp
+/// for (const auto &[key, value] : table) {
+///     // ...
+/// }
+/// ```
+///
+/// Like in `std::unordered_map`, the keys of the entries are constant. The members for buckets, hash
+/// functions and node handles are not provided, and removing an entry keeps the order of the other entries.
+///
+class ValueTable final {
+    // fwd-entry: class ValueTable
+
+public:
+    /// The number of entries up to which the table is searched linearly.
+    ///
+    static constexpr std::size_t cLinearSearchLimit = 16;
+
+public:
+    using key_type = QString; ///< The key type.
+    using mapped_type = ValuePtr; ///< The value type.
+    using value_type = std::pair<const QString, ValuePtr>; ///< The entry type.
+    using size_type = std::size_t; ///< The size type.
+    using iterator = std::vector<value_type>::iterator; ///< The iterator.
+    using const_iterator = std::vector<value_type>::const_iterator; ///< The constant iterator.
+
+public:
+    // defaults
+    ValueTable() = default;
+    ValueTable(const ValueTable&) = default;
+    ValueTable(ValueTable&&) noexcept = default;
+    auto operator=(const ValueTable &other) -> ValueTable&;
+    auto operator=(ValueTable&&) noexcept -> ValueTable& = default;
+    ~ValueTable() = default;
+
+public: // iterators
+    [[nodiscard]] inline auto begin() noexcept -> iterator { return _entries.begin(); }
+    [[nodiscard]] inline auto end() noexcept -> iterator { return _entries.end(); }
+    [[nodiscard]] inline auto begin() const noexcept -> const_iterator { return _entries.begin(); }
+    [[nodiscard]] inline auto end() const noexcept -> const_iterator { return _entries.end(); }
+    [[nodiscard]] inline auto cbegin() const noexcept -> const_iterator { return _entries.cbegin(); }
+    [[nodiscard]] inline auto cend() const noexcept -> const_iterator { return _entries.cend(); }
+
+public: // access
+    /// Get the number of entries.
+    ///
+    [[nodiscard]] inline auto size() const noexcept -> size_type { return _entries.size(); }
+
+    /// Test if the table is empty.
+    ///
+    [[nodiscard]] inline auto empty() const noexcept -> bool { return _entries.empty(); }
+
+    /// Find an entry.
+    ///
+    /// @param key The key to search.
+    /// @return An iterator to the entry, or `end()` if there is no entry with this key.
+    ///
+    [[nodiscard]] auto find(QStringView key) noexcept -> iterator;
+
+    /// @copydoc find(QStringView)
+    ///
+    [[nodiscard]] auto find(QStringView key) const noexcept -> const_iterator;
+
+    /// @copydoc find(QStringView)
+    ///
+    [[nodiscard]] inline auto find(const QString &key) noexcept -> iterator { return find(QStringView{key}); }
+
+    /// @copydoc find(QStringView)
+    ///
+    [[nodiscard]] inline auto find(const QString &key) const noexcept -> const_iterator {
+        return find(QStringView{key});
+    }
+
+    /// Get the number of entries with the given key.
+    ///
+    /// @return 1 if there is an entry with this key, 0 otherwise.
+    ///
+    [[nodiscard]] auto count(QStringView key) const noexcept -> size_type;
+
+    /// @copydoc count(QStringView) const
+    ///
+    [[nodiscard]] inline auto count(const QString &key) const noexcept -> size_type { return count(QStringView{key}); }
+
+    /// Test if there is an entry with the given key.
+    ///
+    [[nodiscard]] auto contains(QStringView key) const noexcept -> bool;
+
+    /// @copydoc contains(QStringView) const
+    ///
+    [[nodiscard]] inline auto contains(const QString &key) const noexcept -> bool { return contains(QStringView{key}); }
+
+    /// Access the value of an entry.
+    ///
+    /// @param key The key of the entry.
+    /// @return The value of the entry.
+    /// @throws std::out_of_range if there is no entry with this key.
+    ///
+    [[nodiscard]] auto at(QStringView key) -> mapped_type&;
+
+    /// @copydoc at(QStringView)
+    ///
+    [[nodiscard]] auto at(QStringView key) const -> const mapped_type&;
+
+    /// @copydoc at(QStringView)
+    ///
+    [[nodiscard]] inline auto at(const QString &key) -> mapped_type& { return at(QStringView{key}); }
+
+    /// @copydoc at(QStringView)
+    ///
+    [[nodiscard]] inline auto at(const QString &key) const -> const mapped_type& { return at(QStringView{key}); }
+
+    /// Access the value of an entry, or add a new entry with an empty value.
+    ///
+    /// @param key The key of the entry.
+    /// @return The value of the entry.
+    ///
+    auto operator[](const QString &key) -> mapped_type&;
+
+public: // modification
+    /// Insert a new entry, if there is no entry with the same key.
+    ///
+    /// @param entry The new entry.
+    /// @return An iterator to the entry with the key and `true` if the new entry was inserted.
+    ///
+    auto insert(value_type entry) -> std::pair<iterator, bool>;
+
+    /// Construct and insert a new entry, if there is no entry with the same key.
+    ///
+    /// @param args The arguments to construct the entry.
+    /// @return An iterator to the entry with the key and `true` if the new entry was inserted.
+    ///
+    template<typename... Args>
+    auto emplace(Args&&... args) -> std::pair<iterator, bool> {
+        return insert(value_type{std::forward<Args>(args)...});
+    }
+
+    /// Insert a new entry or replace the value of an existing entry.
+    ///
+    /// A new entry is added at the end, a replaced entry keeps its position.
+    ///
+    /// @param key The key.
+    /// @param value The value.
+    /// @return An iterator to the entry and `true` if a new entry was inserted.
+    ///
+    auto insert_or_assign(const QString &key, ValuePtr value) -> std::pair<iterator, bool>;
+
+    /// Remove an entry.
+    ///
+    /// @param key The key of the entry to remove.
+    /// @return The number of removed entries.
+    ///
+    auto erase(QStringView key) -> size_type;
+
+    /// @copydoc erase(QStringView)
+    ///
+    inline auto erase(const QString &key) -> size_type { return erase(QStringView{key}); }
+
+    /// Remove the entry at the given position.
+    ///
+    /// @param position The position of the entry to remove.
+    /// @return An iterator to the entry that followed the removed entry.
+    ///
+    auto erase(const_iterator position) -> iterator;
+
+    /// @copydoc erase(const_iterator)
+    ///
+    inline auto erase(iterator position) -> iterator { return erase(const_iterator{position}); }
+
+    /// Remove all entries.
+    ///
+    void clear() noexcept;
+
+    /// Reserve space for entries.
+    ///
+    void reserve(size_type size);
+
+private:
+    /// Add a new entry at the end, without testing if the key exists.
+    ///
+    /// @return An iterator to the new entry.
+    ///
+    auto appendEntry(value_type entry) -> iterator;
+
+    /// Remove the entry with the given index.
+    ///
+    void removeEntry(std::size_t index);
+
+    /// Get the index of the entry with the given key.
+    ///
+    /// @return The index of the entry, or `size()` if there is no entry with this key.
+    ///
+    [[nodiscard]] auto indexOf(QStringView key) const noexcept -> std::size_t;
+
+    /// Compare a key of an entry with another key.
+    ///
+    /// Keys that share the same data, like interned keys from the parser, are equal without comparing the text.
+    ///
+    [[nodiscard]] inline static auto isSameKey(const QString &entryKey, QStringView key) noexcept -> bool {
+        if (entryKey.size() != key.size()) {
+            return false;
+        }
+        return entryKey.constData() == key.data() || QStringView{entryKey} == key;
+    }
+
+    /// Calculate the hash for a key.
+    ///
+    [[nodiscard]] static auto hashKey(QStringView key) noexcept -> std::size_t;
+
+    /// Add the entry with the given index to the hash index.
+    ///
+    void addToIndex(std::size_t entryIndex) noexcept;
+
+    /// Build the hash index for all entries, if the table is large enough.
+    ///
+    void rebuildIndex();
+
+private:
+    std::vector<value_type> _entries; ///< The entries in insertion order.
+    std::vector<uint32_t> _slots; ///< The hash index, with the entry index + 1, or 0 for free slots.
+};
+
+
+}
+
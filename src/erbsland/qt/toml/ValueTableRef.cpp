@@ -0,0 +1,24 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ValueTableRef.hpp"
+
+
+#include "Value.hpp"
+
+
+namespace erbsland::qt::toml {
+
+
+auto ValueTableRef::Iterator::operator*() const noexcept -> reference {
+    return {_it->first, ownerPtr(_it->second)};
+}
+
+
+auto ValueTableRef::ownerPtr(const ValuePtr &value) noexcept -> ValuePtr {
+    return Value::ownerPtr(value);
+}
+
+
+}
+
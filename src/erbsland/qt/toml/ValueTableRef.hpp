@@ -0,0 +1,128 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "ValueTable.hpp"
+
+#include <QtCore/QString>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+
+namespace erbsland::qt::toml {
+
+
+/// A view on the entries of a table value, without copying the table.
+///
+/// The view is returned by `Value::toTableRef()`. Each entry is returned as a pair of a reference to the
+/// stored key and a pointer to the value, that shares the ownership of the document. So you can keep copies
+/// of the pointers, also if the document was parsed with the value arena enabled.
+///
+/// ```cpp
+/// for (const auto &[key, value] : table->toTableRef()) {
+///     // ...
+/// }
+/// ```
+///
+/// The view is valid as long as the table value exists and is not modified.
+///
+class ValueTableRef final {
+    // fwd-entry: class ValueTableRef
+    friend class Value;
+
+public:
+    /// An entry of the table, with the key and the value.
+    ///
+    using Entry = std::pair<const QString&, ValuePtr>;
+
+    /// The iterator over the entries of the table.
+    ///
+    class Iterator final {
+        friend class ValueTableRef;
+
+    public: // definitions to satisfy the iterator concept.
+        /// @private
+        using iterator_category = std::forward_iterator_tag;
+        /// @private
+        using value_type = Entry;
+        /// @private
+        using difference_type = std::ptrdiff_t;
+        /// @private
+        using pointer = void;
+        /// @private
+        using reference = Entry;
+
+    public:
+        /// Create an iterator that does not point to a table.
+        ///
+        Iterator() noexcept = default;
+
+    private:
+        /// Create an iterator from an iterator of the stored table.
+        ///
+        explicit Iterator(ValueTable::const_iterator it) noexcept : _it{it} {}
+
+    public: // operators
+        /// Access the entry.
+        ///
+        [[nodiscard]] auto operator*() const noexcept -> reference;
+
+        /// Increment the iterator.
+        ///
+        inline auto operator++() noexcept -> Iterator& { ++_it; return *this; }
+
+        /// Increment the iterator.
+        ///
+        inline auto operator++(int) noexcept -> Iterator { auto result = *this; ++_it; return result; }
+
+        /// Compare two iterators.
+        ///
+        [[nodiscard]] inline auto operator==(const Iterator &other) const noexcept -> bool { return _it == other._it; }
+
+        /// Compare two iterators.
+        ///
+        [[nodiscard]] inline auto operator!=(const Iterator &other) const noexcept -> bool { return _it != other._it; }
+
+    private:
+        ValueTable::const_iterator _it{}; ///< The iterator of the stored table.
+    };
+
+    using iterator = Iterator; ///< The iterator.
+    using const_iterator = Iterator; ///< The constant iterator.
+    using size_type = std::size_t; ///< The size type.
+
+private:
+    /// Create a view on a stored table.
+    ///
+    explicit ValueTableRef(const ValueTable &table) noexcept : _table{&table} {}
+
+public: // iterators
+    [[nodiscard]] inline auto begin() const noexcept -> Iterator { return Iterator{_table->begin()}; }
+    [[nodiscard]] inline auto end() const noexcept -> Iterator { return Iterator{_table->end()}; }
+
+public: // access
+    /// Get the number of entries.
+    ///
+    [[nodiscard]] inline auto size() const noexcept -> size_type { return _table->size(); }
+
+    /// Test if the table is empty.
+    ///
+    [[nodiscard]] inline auto empty() const noexcept -> bool { return _table->empty(); }
+
+private:
+    /// Convert a stored pointer into a pointer that shares the ownership of the document.
+    ///
+    [[nodiscard]] static auto ownerPtr(const ValuePtr &value) noexcept -> ValuePtr;
+
+private:
+    const ValueTable *_table; ///< The stored table.
+};
+
+
+}
+
@@ -8,13 +8,15 @@
 
 #include <QtCore/QString>
 
+#include <cstdint>
+
 
 namespace erbsland::qt::toml {
 
 
 /// The type of a value.
 ///
-enum class ValueType {
+enum class ValueType : uint8_t {
     Integer, ///< A signed integer.
     Float, ///< A floating-point number.
     Boolean, ///< A boolean value (either `true` or `false`).
@@ -5,16 +5,27 @@
 
 
 #include "Char.hpp"
+#include "DocumentCache.hpp"
 #include "Error.hpp"
+#include "IncrementalParser.hpp"
 #include "InputStream.hpp"
+#include "KeyPath.hpp"
 #include "Location.hpp"
 #include "LocationFormat.hpp"
 #include "LocationRange.hpp"
 #include "Namespace.hpp"
 #include "Parser.hpp"
+#include "ParserHandler.hpp"
+#include "ParserPool.hpp"
+#include "Snapshot.hpp"
 #include "Specification.hpp"
+#include "Timestamp.hpp"
+#include "TomlReader.hpp"
 #include "Value.hpp"
+#include "ValueArrayRef.hpp"
 #include "ValueSource.hpp"
+#include "ValueTable.hpp"
+#include "ValueTableRef.hpp"
 #include "ValueType.hpp"
 
 
@@ -17,6 +17,17 @@ class Value;
 class Error;
 class InputStream;
 class Location;
+class ValueTable;
+class ValueArrayRef;
+class ValueTableRef;
+class KeyPath;
+class ParserPool;
+class IncrementalParser;
+class ParserHandler;
+class TomlReader;
+class Timestamp;
+class DocumentCache;
+class Snapshot;
 
 
 }
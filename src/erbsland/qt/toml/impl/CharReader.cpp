@@ -4,6 +4,8 @@
 #include "CharReader.hpp"
 
 
+#include "StringInputStream.hpp"
+
 #include "../Error.hpp"
 
 
@@ -14,61 +16,126 @@ CharReader::CharReader(Specification specification) noexcept : _specification{sp
 }
 
 
-void CharReader::resetWithInputStream(InputStreamPtr inputStream) noexcept {
+void CharReader::resetWithInputStream(InputStreamPtr inputStream, const Location &startLocation) noexcept {
     _stream = std::move(inputStream);
     _hasChar = false;
     _char = {};
-    _location = {};
+    _index = startLocation.index();
+    _line = startLocation.line();
+    _lineStartIndex = startLocation.index() - (startLocation.column() - 1);
     _token.clear();
     _token.reserve(128);
-    _startLocation = {};
+    if (_stream == nullptr) {
+        _textArena.release(); // do not keep the memory while the reader is not used.
+    } else {
+        _textArena.clear();
+    }
+    _startLocation = startLocation;
+    _charBufferPosition = 0;
+    _charBufferSize = 0;
+    _stringStream = dynamic_cast<StringInputStream*>(_stream.get());
+    _text = (_stringStream != nullptr) ? QStringView{_stringStream->text()} : QStringView{};
+    _textPosition = 0;
+    _charOffset = 0;
+    _isTokenSlice = (_stringStream != nullptr);
+    _sliceBegin = 0;
+    _sliceEnd = 0;
 }
 
 
-auto CharReader::takeToken() noexcept -> std::tuple<QString, LocationRange> {
-    auto result = std::make_tuple(_token, LocationRange{_startLocation, _location});
-    _token.clear();
-    _startLocation = _location;
-    _token.clear();
+auto CharReader::takeToken() -> std::tuple<QStringView, LocationRange> {
+    auto result = std::make_tuple(
+        _isTokenSlice ? token() : _textArena.store(_token),
+        LocationRange{_startLocation, location()});
+    discardToken();
     return result;
 }
 
 
+void CharReader::releaseTokenTexts() noexcept {
+    _textArena.clear();
+}
+
+
+void CharReader::discardToken() noexcept {
+    _startLocation = location();
+    _token.resize(0); // keep the capacity of the buffer.
+    _isTokenSlice = (_stringStream != nullptr);
+    _sliceBegin = 0;
+    _sliceEnd = 0;
+}
+
+
 void CharReader::readNextChar() {
     if (!_hasChar) {
-        try {
-            _char = _stream->readOrThrow();
-        } catch (const Error &error) {
-            throw Error::createEncoding(error.document(), _location);
-        }
-        _hasChar = !(_char.isNull() && _stream->atEnd());
+        _char = readFromStream();
+        _hasChar = !(_char.isNull() && streamAtEnd());
+    }
+}
+
+
+auto CharReader::readSurrogateFromText() -> Char {
+    try {
+        return _stringStream->decodeOrThrow(_textPosition);
+    } catch (const Error &error) {
+        throw Error::createEncoding(error.document(), location());
     }
 }
 
 
+void CharReader::copySliceToToken() noexcept {
+    _token.append(token());
+    _isTokenSlice = false;
+}
+
+
+auto CharReader::readBlockFromStream() -> Char {
+    _charBufferPosition = 0;
+    _charBufferSize = 0;
+    try {
+        _charBufferSize = _stream->readBlockOrThrow(_charBuffer.data(), cCharBufferSize);
+    } catch (const Error &error) {
+        throw Error::createEncoding(error.document(), location());
+    }
+    if (_charBufferSize == 0) {
+        return {};
+    }
+    _charBufferPosition = 1;
+    return _charBuffer[0];
+}
+
+
 auto CharReader::consumeChar() -> StreamState {
-    _char.appendToString(_token);
+    if (_isTokenSlice && (_sliceBegin == _sliceEnd || _sliceEnd == _charOffset)) {
+        if (_sliceBegin == _sliceEnd) {
+            _sliceBegin = _charOffset;
+        }
+        _sliceEnd = _textPosition; // the current character is directly before the read position.
+    } else {
+        writeToToken(_char);
+    }
     return skipChar();
 }
 
 
 auto CharReader::skipChar() -> StreamState {
-    _location.increment(_char == 0x0aU);
-    try {
-        _char = _stream->readOrThrow();
-    } catch (const Error &error) {
-        throw Error::createEncoding(error.document(), _location);
+    _index += 1;
+    if (_char == 0x0aU) {
+        _line += 1;
+        _lineStartIndex = _index;
     }
-    _hasChar = !(_char.isNull() && _stream->atEnd());
+    _char = readFromStream();
+    _hasChar = !(_char.isNull() && streamAtEnd());
     return _hasChar ? StreamState::MoreData : StreamState::EndOfStream;
 }
 
 
 auto CharReader::lastConsumed() const noexcept -> QChar {
-    if (_token.isEmpty()) {
+    const auto text = token();
+    if (text.isEmpty()) {
         return {};
     }
-    return _token.at(_token.size() - 1);
+    return text.at(text.size() - 1);
 }
 
 
@@ -100,7 +167,7 @@ auto CharReader::skipWhiteSpace() -> StreamState {
             return StreamState::EndOfStream;
         }
     }
-    if (_stream->atEnd()) {
+    if (streamAtEnd()) {
         return StreamState::EndOfStream;
     }
     return StreamState::MoreData;
@@ -115,6 +182,9 @@ void CharReader::expectMoreData(StreamState streamState) {
 
 
 void CharReader::writeToToken(Char newChar) noexcept {
+    if (_isTokenSlice) {
+        copySliceToToken();
+    }
     newChar.appendToString(_token);
 }
 
@@ -156,22 +226,23 @@ auto CharReader::consumeDigits(NumberSystem numberSystem, bool lastConsumedWasDi
             }
             lastConsumedWasDigit = true;
         }
-        if (_token.size() > cIntOrFloatCharacterLimit) {
+        if (tokenSize() > cIntOrFloatCharacterLimit) {
             throwNumberExceedsLimits();
         }
     }
     if (!lastConsumedWasDigit) {
         throwSyntaxError(QStringLiteral("The last character in a number must not be an underscore."));
     }
-    if (_stream->atEnd()) {
+    if (streamAtEnd()) {
         return StreamState::EndOfStream;
     }
     return StreamState::MoreData;
 }
 
 
-auto CharReader::consumeDecimalDigits(int32_t count) -> StreamState {
+auto CharReader::consumeDecimalDigits(int32_t count, int32_t &value) -> StreamState {
     auto state = StreamState::MoreData;
+    value = 0;
     for (int32_t i = 0; i < count; ++i) {
         if (state == StreamState::EndOfStream) {
             throwPrematureEnd();
@@ -179,6 +250,7 @@ auto CharReader::consumeDecimalDigits(int32_t count) -> StreamState {
         if (!isDecimalDigit()) {
             throwUnexpectedCharacter();
         }
+        value = value * 10 + static_cast<int32_t>(_char.toAscii() - '0');
         state = consumeChar();
     }
     return state;
@@ -186,7 +258,7 @@ auto CharReader::consumeDecimalDigits(int32_t count) -> StreamState {
 
 
 void CharReader::throwSyntaxError(const QString& message) {
-    throw Error::createSyntax(_stream->document(), _location, message);
+    throw Error::createSyntax(_stream->document(), location(), message);
 }
 
 
@@ -207,7 +279,7 @@ void CharReader::throwNumberExceedsLimits() {
 
 auto CharReader::tokenMatches(const std::vector<const char *> &stringList) const noexcept -> bool {
     return std::any_of(stringList.cbegin(), stringList.cend(), [&](const char *str) -> bool {
-        return _token == str;
+        return token() == QLatin1String(str);
     });
 }
 
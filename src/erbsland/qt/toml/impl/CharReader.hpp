@@ -6,6 +6,7 @@
 
 #include "NumberSystem.hpp"
 #include "StreamState.hpp"
+#include "TextArena.hpp"
 #include "Token.hpp"
 #include "TokenType.hpp"
 
@@ -13,12 +14,18 @@
 #include "../LocationRange.hpp"
 #include "../Specification.hpp"
 
+#include <QtCore/QStringView>
+
+#include <array>
 #include <tuple>
 
 
 namespace erbsland::qt::toml::impl {
 
 
+class StringInputStream;
+
+
 /// @private
 /// A class specialized reading characters from the stream, classify them and assemble tokens.
 ///
@@ -26,12 +33,20 @@ namespace erbsland::qt::toml::impl {
 /// actual logic. While there is not a perfect clear separation between the reader and
 /// the tokenizer, it helps to make the code of the tokenizer more readable.
 ///
+/// If the stream is a string stream, the reader iterates the text of the string directly. In this case,
+/// a token that consists of consecutive characters from the text is kept as a slice of the text, and
+/// only copied into the token buffer if other characters are written or characters are skipped in between.
+///
 class CharReader final {
 private:
     /// The maximum number of digits of an integer/float (for the token).
     ///
     static constexpr int32_t cIntOrFloatCharacterLimit = 100;
 
+    /// The number of characters read from the stream in one block.
+    ///
+    static constexpr qsizetype cCharBufferSize = 0x1000;
+
 public:
     /// Create a new character reader.
     ///
@@ -48,7 +63,11 @@ public: // low-level
 
     /// Set the input stream.
     ///
-    void resetWithInputStream(InputStreamPtr inputStream) noexcept;
+    /// @param inputStream The input stream.
+    /// @param startLocation The location of the first character in the stream. This must be the start of
+    ///     a line, if the stream is a part of a larger document.
+    ///
+    void resetWithInputStream(InputStreamPtr inputStream, const Location &startLocation = {}) noexcept;
 
     /// Access the last read character.
     ///
@@ -63,7 +82,7 @@ public: // low-level
     /// Test if the stream is at the end.
     ///
     inline auto atEnd() noexcept -> bool {
-        return _char.isNull() && _stream->atEnd();
+        return _char.isNull() && streamAtEnd();
     }
 
 public: // Skip and consume characters.
@@ -154,30 +173,39 @@ public: // Skip and consume characters.
 
     /// Consume a number of decimal digits.
     ///
-    [[nodiscard]] auto consumeDecimalDigits(int32_t count) -> StreamState;
+    /// @param count The number of digits.
+    /// @param value Receives the value of the digits.
+    ///
+    [[nodiscard]] auto consumeDecimalDigits(int32_t count, int32_t &value) -> StreamState;
 
     /// Consume a number of decimal digits and expect more after them.
     ///
-    inline void consumeDecimalDigitsAndExpectMore(int32_t count) {
-        expectMoreData(consumeDecimalDigits(count));
+    inline void consumeDecimalDigitsAndExpectMore(int32_t count, int32_t &value) {
+        expectMoreData(consumeDecimalDigits(count, value));
     }
 
     /// Consume a number of decimal digits and test if the end of the stream was reached.
     ///
-    inline auto consumeDecimalDigitsAndTestAtEnd(int32_t count) -> bool {
-        return consumeDecimalDigits(count) == StreamState::EndOfStream;
+    inline auto consumeDecimalDigitsAndTestAtEnd(int32_t count, int32_t &value) -> bool {
+        return consumeDecimalDigits(count, value) == StreamState::EndOfStream;
     }
 
 public: // token buffer functions
     /// Get the current size of the token.
     ///
     [[nodiscard]] inline auto tokenSize() const noexcept -> qsizetype {
+        if (_isTokenSlice) {
+            return _sliceEnd - _sliceBegin;
+        }
         return _token.size();
     }
 
-    /// Access the current token buffer
+    /// Access the current token text.
     ///
-    [[nodiscard]] inline auto token() const noexcept -> const QString& {
+    [[nodiscard]] inline auto token() const noexcept -> QStringView {
+        if (_isTokenSlice) {
+            return _text.mid(_sliceBegin, _sliceEnd - _sliceBegin);
+        }
         return _token;
     }
 
@@ -189,9 +217,22 @@ public: // token buffer functions
 
     /// Get and clear the token buffer
     ///
+    /// The returned text is either a slice of the source text or stored in the text arena of this reader.
+    /// It stays valid until the token texts are released or the reader is reset.
+    ///
     /// @return The buffer contents, the location range of the token.
     ///
-    auto takeToken() noexcept -> std::tuple<QString, LocationRange>;
+    auto takeToken() -> std::tuple<QStringView, LocationRange>;
+
+    /// Release the texts of all tokens that were taken from this reader.
+    ///
+    /// Call this method only if none of the previous tokens is used anymore.
+    ///
+    void releaseTokenTexts() noexcept;
+
+    /// Clear the token buffer and start a new token at the current location, without creating a token.
+    ///
+    void discardToken() noexcept;
 
     /// Write a character to the token buffer.
     ///
@@ -310,7 +351,7 @@ public: // character testing
         return _char == 'z' || _char == 'Z';
     }
     [[nodiscard]] inline auto isPossibleValueEnd() const noexcept -> bool {
-        return _stream->atEnd() || isWhiteSpace() || isNewLineOrCarriageReturn() || isComma() || isComment()
+        return streamAtEnd() || isWhiteSpace() || isNewLineOrCarriageReturn() || isComma() || isComment()
                || isTableEnd() || isArrayEnd();
     }
     [[nodiscard]] inline auto isPossibleBareKeyEnd() const noexcept -> bool {
@@ -334,14 +375,80 @@ public: // throw exceptions
     ///
     [[noreturn]] void throwNumberExceedsLimits();
 
+private:
+    /// Get the location of the current character.
+    ///
+    /// Only the index and line are counted while reading, the column is calculated from the start of the line.
+    ///
+    [[nodiscard]] inline auto location() const noexcept -> Location {
+        return {_index, _line, _index - _lineStartIndex + 1};
+    }
+
+    /// Test if there are no more characters after the current one.
+    ///
+    [[nodiscard]] inline auto streamAtEnd() const noexcept -> bool {
+        if (_stringStream != nullptr) {
+            return _textPosition >= _text.size();
+        }
+        return _charBufferPosition >= _charBufferSize && _stream->atEnd();
+    }
+
+    /// Get the next character from the text or the character buffer, or read a new block from the stream.
+    ///
+    inline auto readFromStream() -> Char {
+        if (_stringStream != nullptr) {
+            _charOffset = _textPosition;
+            if (_textPosition >= _text.size()) {
+                return {};
+            }
+            const auto character = _text[_textPosition];
+            if (character.isSurrogate()) {
+                return readSurrogateFromText();
+            }
+            _textPosition += 1;
+            return Char{static_cast<char32_t>(character.unicode())};
+        }
+        if (_charBufferPosition < _charBufferSize) {
+            return _charBuffer[static_cast<std::size_t>(_charBufferPosition++)];
+        }
+        return readBlockFromStream();
+    }
+
+    /// Decode a surrogate pair from the text.
+    ///
+    auto readSurrogateFromText() -> Char;
+
+    /// Copy the slice of the text into the token buffer.
+    ///
+    void copySliceToToken() noexcept;
+
+    /// Read the next block of characters from the stream.
+    ///
+    /// @return The first character of the block, or a null character at the end of the stream.
+    ///
+    auto readBlockFromStream() -> Char;
+
 private:
     Specification _specification{}; ///< The version of the specification to use
     InputStreamPtr _stream{}; ///< The current assigned input stream.
     bool _hasChar{false}; ///< If a character was read from the stream.
     Char _char{}; ///< The last read character.
-    Location _location{}; ///< The current read location.
+    int64_t _index{}; ///< The index of the current character.
+    int64_t _line{1}; ///< The line of the current character.
+    int64_t _lineStartIndex{}; ///< The index of the first character in the current line.
     Location _startLocation{}; ///< The location at the token start.
     QString _token{}; ///< The current token.
+    TextArena _textArena{}; ///< The storage for the texts of tokens that are not a slice of the source text.
+    std::array<Char, cCharBufferSize> _charBuffer{}; ///< The block of characters read from the stream.
+    qsizetype _charBufferPosition{}; ///< The read position in the character buffer.
+    qsizetype _charBufferSize{}; ///< The number of characters in the character buffer.
+    StringInputStream *_stringStream{}; ///< The string stream, if the text is read directly from the string.
+    QStringView _text{}; ///< The text of the string stream.
+    qsizetype _textPosition{}; ///< The read position in the text.
+    qsizetype _charOffset{}; ///< The position of the current character in the text.
+    bool _isTokenSlice{false}; ///< If the token is the slice `_sliceBegin` to `_sliceEnd` of the text.
+    qsizetype _sliceBegin{}; ///< The begin of the token slice in the text.
+    qsizetype _sliceEnd{}; ///< The end of the token slice in the text.
 };
 
 
@@ -10,14 +10,17 @@
 namespace erbsland::qt::toml::impl {
 
 
-DataInputStream::DataInputStream(QByteArray data) noexcept
-    : TextStreamInputStream{InputStream::Type::Data}, _dataCopy{std::move(data)} {
+DataInputStream::DataInputStream(QByteArray data, QString document) noexcept
+    : TextStreamInputStream{InputStream::Type::Data}, _document{std::move(document)} {
 
-    _dataStream = std::make_unique<QDataStream>(&_dataCopy, QIODevice::ReadOnly);
+    setData(std::move(data));
 }
 
 
 auto DataInputStream::document() const noexcept -> QString {
+    if (!_document.isEmpty()) {
+        return _document;
+    }
     return QStringLiteral("[data]");
 }
 
@@ -18,14 +18,15 @@ public:
     /// Create a new input stream based on UTF-8 encoded byte data.
     ///
     /// @param data The array with the byte data.
+    /// @param document The document name for errors, or an empty string for `[data]`.
     ///
-    explicit DataInputStream(QByteArray data) noexcept;
+    explicit DataInputStream(QByteArray data, QString document = {}) noexcept;
 
 public: // implement InputStream
     [[nodiscard]] auto document() const noexcept -> QString override;
 
 private:
-    QByteArray _dataCopy{}; ///< A copy of the data for the stream.
+    QString _document; ///< The document name for errors, or an empty string.
 };
 
 
@@ -0,0 +1,42 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <cstdint>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// The numbers of a date, time or date/time token.
+///
+/// The fields are captured by the tokenizer while it reads the digits. The numbers are not verified,
+/// e.g. the hour can be 99. Fields that are not part of the token are zero.
+///
+struct DateTimeFields {
+    uint16_t year{}; ///< The year.
+    uint8_t month{}; ///< The month.
+    uint8_t day{}; ///< The day.
+    uint8_t hour{}; ///< The hour.
+    uint8_t minute{}; ///< The minute.
+    uint8_t second{}; ///< The second, or zero if the time has no seconds.
+    uint32_t nanosecond{}; ///< The first nine digits of the fraction, in nanoseconds.
+    bool hasOffset{false}; ///< If the time has an offset, or the `Z` suffix.
+    bool isNegativeOffset{false}; ///< If the offset is negative.
+    uint8_t offsetHour{}; ///< The hour of the offset.
+    uint8_t offsetMinute{}; ///< The minute of the offset.
+
+    /// Get the signed offset in seconds.
+    ///
+    [[nodiscard]] inline auto offsetSeconds() const noexcept -> int {
+        const auto seconds = 3600 * static_cast<int>(offsetHour) + 60 * static_cast<int>(offsetMinute);
+        return isNegativeOffset ? -seconds : seconds;
+    }
+};
+
+
+}
+
@@ -19,7 +19,7 @@ FileInputStream::FileInputStream(QString path)
     if (!_file->open(QIODevice::ReadOnly)) {
         throw Error::createIO(_path, *_file);
     }
-    _dataStream = std::make_unique<QDataStream>(_file.get());
+    setDevice(_file.get());
 }
 
 
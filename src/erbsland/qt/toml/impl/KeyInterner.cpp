@@ -0,0 +1,35 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "KeyInterner.hpp"
+
+
+#include <QtCore/QHash>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+auto KeyInterner::intern(QStringView key) -> QString {
+    if (auto it = _keys.find(key); it != _keys.end()) {
+        return *it->second;
+    }
+    const auto &text = _strings.emplace_back(key.toString());
+    _keys.emplace(QStringView{text}, &text);
+    return text;
+}
+
+
+void KeyInterner::clear() noexcept {
+    _keys.clear();
+    _strings.clear();
+}
+
+
+auto KeyInterner::Hash::operator()(QStringView key) const noexcept -> std::size_t {
+    return static_cast<std::size_t>(qHash(key));
+}
+
+
+}
+
@@ -0,0 +1,51 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <QtCore/QString>
+#include <QtCore/QStringView>
+
+#include <deque>
+#include <unordered_map>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// A per-document storage that shares identical keys.
+///
+/// Documents with arrays of tables repeat the same keys many times. The interner returns the same implicitly
+/// shared `QString` for identical keys, so each distinct key is stored only once and tables can compare
+/// the keys by their data pointer first.
+///
+class KeyInterner final {
+public:
+    /// Get the shared string for a key.
+    ///
+    /// @param key The key text.
+    /// @return A shared copy of the string for this key.
+    ///
+    [[nodiscard]] auto intern(QStringView key) -> QString;
+
+    /// Remove all keys from the interner.
+    ///
+    void clear() noexcept;
+
+private:
+    /// The hash function for the keys.
+    ///
+    struct Hash {
+        auto operator()(QStringView key) const noexcept -> std::size_t;
+    };
+
+private:
+    std::deque<QString> _strings; ///< The stored strings, with stable addresses.
+    std::unordered_map<QStringView, const QString*, Hash> _keys; ///< The index, each view points into a stored string.
+};
+
+
+}
+
@@ -0,0 +1,41 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "MappedFileInputStream.hpp"
+
+
+#include "../Error.hpp"
+
+#include <utility>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+MappedFileInputStream::MappedFileInputStream(QString path)
+    : TextStreamInputStream{InputStream::Type::File}, _path{std::move(path)} {
+
+    _file = std::make_unique<QFile>(_path);
+    if (!_file->open(QIODevice::ReadOnly)) {
+        throw Error::createIO(_path, *_file);
+    }
+    const auto fileSize = _file->size();
+    uchar *mapping = nullptr;
+    if (fileSize > 0 && fileSize <= cMaximumMappedSize) {
+        mapping = _file->map(0, fileSize);
+    }
+    if (mapping != nullptr) {
+        setData(QByteArray::fromRawData(reinterpret_cast<const char*>(mapping), static_cast<qsizetype>(fileSize)));
+    } else {
+        setDevice(_file.get());
+    }
+}
+
+
+auto MappedFileInputStream::document() const noexcept -> QString {
+    return _path;
+}
+
+
+}
+
@@ -0,0 +1,58 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "TextStreamInputStream.hpp"
+
+#include <QtCore/QFile>
+
+#include <limits>
+#include <memory>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// A input stream decoding UTF-8 data from a memory mapped file.
+///
+/// The file is mapped read-only into memory and decoded directly from the mapping, without copying the data.
+/// If the file cannot be mapped, e.g. because it is empty, a special file or larger than a byte array can be,
+/// the stream transparently falls back to reading the file block-wise.
+///
+/// @warning If the file is truncated by another process while it is mapped, accessing the removed part of
+///     the mapping can terminate the process (e.g. with `SIGBUS` on POSIX systems).
+///
+class MappedFileInputStream final : public TextStreamInputStream {
+public:
+    /// The largest file size that can be wrapped into a byte array.
+    ///
+    /// Qt 5 uses `int` for the size of byte arrays, so larger mappings would be silently truncated.
+    ///
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    static constexpr qint64 cMaximumMappedSize = std::numeric_limits<int>::max();
+#else
+    static constexpr qint64 cMaximumMappedSize = std::numeric_limits<qsizetype>::max();
+#endif
+
+public:
+    /// Create a new memory mapped file stream.
+    ///
+    /// @param path The absolute path to the file.
+    /// @throws Error if the file cannot be opened.
+    ///
+    explicit MappedFileInputStream(QString path);
+
+public: // implement InputStream
+    [[nodiscard]] auto document() const noexcept -> QString override;
+
+private:
+    QString _path{}; ///< The path to the file.
+    std::unique_ptr<QFile> _file{}; ///< The mapped file, which has to stay open while the mapping is used.
+};
+
+
+}
+
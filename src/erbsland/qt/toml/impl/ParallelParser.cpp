@@ -0,0 +1,196 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ParallelParser.hpp"
+
+
+#include "ParserData.hpp"
+#include "WorkerGroup.hpp"
+
+#include "../InputStream.hpp"
+
+#include <QtCore/QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+ParallelParser::ParallelParser(
+    Specification specification,
+    bool isValueArenaEnabled,
+    bool isValueLocationEnabled,
+    bool isLazyValueEnabled) noexcept
+:
+    _specification{specification},
+    _isValueArenaEnabled{isValueArenaEnabled},
+    _isValueLocationEnabled{isValueLocationEnabled},
+    _isLazyValueEnabled{isLazyValueEnabled} {
+}
+
+
+auto ParallelParser::parse(const QByteArray &data) noexcept -> ValuePtr {
+    if (data.size() < 2 * cMinimumChunkSize) {
+        return {};
+    }
+    auto *threadPool = QThreadPool::globalInstance();
+    const auto threadCount = static_cast<qsizetype>(std::max(threadPool->maxThreadCount(), 1));
+    if (threadCount < 2) {
+        return {};
+    }
+    const auto chunkSize = std::max(cMinimumChunkSize, data.size() / (threadCount * cChunksPerWorker));
+    const auto chunks = SectionScanner::splitIntoChunks(data, chunkSize);
+    if (chunks.size() < 2) {
+        return {};
+    }
+    const auto chunkSections = parseChunks(data, chunks);
+    if (chunkSections.empty()) {
+        return {};
+    }
+    return mergeChunks(chunkSections);
+}
+
+
+auto ParallelParser::parseChunks(const QByteArray &data, const std::vector<DocumentChunk> &chunks) noexcept
+    -> std::vector<ParserSectionList> {
+
+    std::vector<ParserSectionList> chunkSections(chunks.size());
+    std::atomic<std::size_t> nextIndex{0};
+    std::atomic<bool> hasFailed{false};
+    auto *threadPool = QThreadPool::globalInstance();
+    WorkerGroup::run(threadPool, WorkerGroup::workerCount(threadPool, chunks.size()), [&]() {
+        ParserData parserData{_specification};
+        parserData.setValueArenaEnabled(_isValueArenaEnabled);
+        parserData.setValueLocationEnabled(_isValueLocationEnabled);
+        parserData.setLazyValuesEnabled(_isLazyValueEnabled);
+        for (auto index = nextIndex++; index < chunks.size() && !hasFailed; index = nextIndex++) {
+            const auto &chunk = chunks[index];
+            try {
+                // The chunk data refers to the document data, which stays valid until all workers are done.
+                const auto chunkData = QByteArray::fromRawData(data.constData() + chunk.begin, chunk.end - chunk.begin);
+                chunkSections[index] = parserData.parseSections(InputStream::createFromData(chunkData), chunk.location);
+            } catch (const std::exception&) {
+                hasFailed = true;
+            }
+        }
+    });
+    if (hasFailed) {
+        return {};
+    }
+    return chunkSections;
+}
+
+
+auto ParallelParser::mergeChunks(const std::vector<ParserSectionList> &chunkSections) noexcept -> ValuePtr {
+    try {
+        auto document = Value::createTable(Value::Source::ExplicitTable);
+        for (const auto &sections : chunkSections) {
+            for (const auto &section : sections) {
+                const auto table = section.keys.empty() ? document : mergeHeader(document, section);
+                if (table == nullptr || !moveAssignments(section, table)) {
+                    return {};
+                }
+            }
+        }
+        const auto &lastRoot = chunkSections.back().front().table;
+        setValueLocation(document, {{}, lastRoot->locationRange().end()}); // the whole document.
+        return document;
+    } catch (const std::exception&) {
+        return {};
+    }
+}
+
+
+auto ParallelParser::mergeHeader(const ValuePtr &document, const ParserSection &section) -> ValuePtr {
+    // Follow the same rules as `ParserData::createIntermediateNameElements()` for table headers.
+    auto table = document;
+    for (auto it = section.keys.begin(); it != std::prev(section.keys.end()); ++it) {
+        auto value = table->valueFromKey(*it);
+        if (value == nullptr) {
+            auto newTable = Value::createTable(Value::Source::ImplicitTable);
+            setValueLocation(newTable, section.implicitRange);
+            table->setValue(*it, newTable);
+            table = newTable;
+            continue;
+        }
+        if (value->source() == Value::Source::Value) {
+            return {};
+        }
+        if (value->isArray()) {
+            if (value->size() == 0) {
+                return {};
+            }
+            value = value->value(value->size() - 1);
+            if (!value->isTable()) {
+                return {};
+            }
+        }
+        table = value;
+    }
+    // Follow the same rules as `ParserData::createTable()` and `ParserData::createArrayOfTables()`.
+    const auto &key = section.keys.back();
+    auto value = table->valueFromKey(key);
+    if (section.isArrayOfTables) {
+        if (value == nullptr) {
+            value = Value::createArray(Value::Source::ExplicitTable);
+            setValueLocation(value, section.headerRange);
+            table->setValue(key, value);
+        } else if (!value->isArray() || value->source() == Value::Source::Value) {
+            return {};
+        }
+        auto newTable = adoptOrCreateTable(section);
+        value->addValue(newTable);
+        return newTable;
+    }
+    if (value == nullptr) {
+        auto newTable = adoptOrCreateTable(section);
+        table->setValue(key, newTable);
+        return newTable;
+    }
+    if (!value->isTable() || value->source() != Value::Source::ImplicitTable) {
+        return {};
+    }
+    value->makeExplicit();
+    setValueLocation(value, section.headerRange); // update the location with the explicit definition.
+    return value;
+}
+
+
+auto ParallelParser::moveAssignments(const ParserSection &section, const ValuePtr &table) -> bool {
+    if (table == section.table) {
+        return true; // the table of the section was adopted.
+    }
+    const auto &entries = section.table->tableStorage();
+    auto it = entries.begin() + static_cast<std::ptrdiff_t>(section.bodyBegin);
+    const auto end = entries.begin() + static_cast<std::ptrdiff_t>(section.bodyEnd);
+    for (; it != end; ++it) {
+        if (table->hasKey(it->first)) {
+            return false;
+        }
+        table->setValue(it->first, section.table->valueFromKey(it->first)); // an owning pointer for arena values.
+    }
+    return true;
+}
+
+
+auto ParallelParser::adoptOrCreateTable(const ParserSection &section) -> ValuePtr {
+    if (section.bodyBegin == 0 && section.bodyEnd == section.table->size()) {
+        return section.table;
+    }
+    auto table = Value::createTable(Value::Source::ExplicitTable);
+    setValueLocation(table, section.headerRange);
+    return table;
+}
+
+
+void ParallelParser::setValueLocation(const ValuePtr &value, const LocationRange &locationRange) const noexcept {
+    if (_isValueLocationEnabled) {
+        value->setLocationRange(locationRange);
+    }
+}
+
+
+}
+
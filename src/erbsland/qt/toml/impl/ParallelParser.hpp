@@ -0,0 +1,110 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "ParserSection.hpp"
+#include "SectionScanner.hpp"
+
+#include "../Specification.hpp"
+#include "../Value.hpp"
+
+#include <QtCore/QByteArray>
+
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// Speculative parallel parsing of a large document.
+///
+/// The document is split at table headers into chunks, using `SectionScanner`. The chunks are parsed
+/// in parallel on the threads of the global thread pool, and the recorded sections of all chunks are merged
+/// into one document, with the same rules as the sequential parser uses for table headers.
+///
+/// The parse is speculative: If a chunk has an error, or the sections can not be merged, no document is
+/// returned and the document has to be parsed sequentially. This way, the result and all reported errors
+/// are exactly the same as for a sequential parse.
+///
+class ParallelParser final {
+public:
+    /// The minimum size of a chunk in bytes.
+    ///
+    static constexpr qsizetype cMinimumChunkSize = 0x40000;
+
+    /// The number of chunks per worker, to balance chunks with a different complexity.
+    ///
+    static constexpr qsizetype cChunksPerWorker = 4;
+
+public:
+    /// Create a new parallel parser.
+    ///
+    /// @param specification The specification version to use.
+    /// @param isValueArenaEnabled If the values are allocated in value arenas.
+    /// @param isValueLocationEnabled If the location ranges are stored in the values.
+    /// @param isLazyValueEnabled If scalar values are converted on the first access.
+    ///
+    ParallelParser(
+        Specification specification,
+        bool isValueArenaEnabled,
+        bool isValueLocationEnabled,
+        bool isLazyValueEnabled) noexcept;
+
+public:
+    /// Parse a document in parallel.
+    ///
+    /// @param data The complete UTF-8 encoded document.
+    /// @return The parsed document, or `nullptr` if the document is too small, can not be split or merged,
+    ///     or if it contains an error.
+    ///
+    [[nodiscard]] auto parse(const QByteArray &data) noexcept -> ValuePtr;
+
+private:
+    /// Parse all chunks in parallel.
+    ///
+    /// @return The sections of each chunk, or an empty list if any chunk failed.
+    ///
+    [[nodiscard]] auto parseChunks(const QByteArray &data, const std::vector<DocumentChunk> &chunks) noexcept
+        -> std::vector<ParserSectionList>;
+
+    /// Merge the sections of all chunks into one document.
+    ///
+    /// @return The merged document, or `nullptr` if the sections could not be merged.
+    ///
+    [[nodiscard]] auto mergeChunks(const std::vector<ParserSectionList> &chunkSections) noexcept -> ValuePtr;
+
+    /// Replay the header of a section on the merged document.
+    ///
+    /// @return The table for the assignments of the section, or `nullptr` if the header is not valid.
+    ///
+    [[nodiscard]] auto mergeHeader(const ValuePtr &document, const ParserSection &section) -> ValuePtr;
+
+    /// Move the assignments of a section into a table of the merged document.
+    ///
+    /// @return `false` if a key of an assignment already exists in the table.
+    ///
+    [[nodiscard]] static auto moveAssignments(const ParserSection &section, const ValuePtr &table) -> bool;
+
+    /// Use the table of a section in the merged document, or create a new one.
+    ///
+    /// The table of a section is only used, if it contains nothing but the assignments of the section.
+    ///
+    [[nodiscard]] auto adoptOrCreateTable(const ParserSection &section) -> ValuePtr;
+
+    /// Set the location range of a value, if this is enabled.
+    ///
+    void setValueLocation(const ValuePtr &value, const LocationRange &locationRange) const noexcept;
+
+private:
+    Specification _specification; ///< The version of the specification to use.
+    bool _isValueArenaEnabled; ///< If the values are allocated in value arenas.
+    bool _isValueLocationEnabled; ///< If the location ranges are stored in the values.
+    bool _isLazyValueEnabled; ///< If scalar values are converted on the first access.
+};
+
+
+}
+
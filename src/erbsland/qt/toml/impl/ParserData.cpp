@@ -4,11 +4,11 @@
 #include "ParserData.hpp"
 
 
-#include "../Error.hpp"
+#include "ParallelParser.hpp"
+#include "ScalarConverter.hpp"
+#include "TextStreamInputStream.hpp"
 
-#include <QtCore/QTime>
-#include <QtCore/QDate>
-#include <QtCore/QDateTime>
+#include "../Error.hpp"
 
 
 namespace erbsland::qt::toml::impl {
@@ -16,62 +16,251 @@ namespace erbsland::qt::toml::impl {
 
 ParserData::ParserData(Specification specification) noexcept
     : _specification{specification}, _tokenizer{specification} {
+    _tokenizer.setSkipWhitespaceAndComments(true);
 }
 
 
-auto ParserData::parseStream(const InputStreamPtr &inputStream) -> ValuePtr {
+auto ParserData::parseStream(const InputStreamPtr &inputStream, const Location &startLocation) -> ValuePtr {
+    if (_isParallelParsingEnabled && _handler == nullptr) {
+        if (auto document = parseInParallel(inputStream); document != nullptr) {
+            return document;
+        }
+    }
     try {
-        _tokenizer.startWithStream(inputStream);
+        // With a handler, the placeholders are replaced while parsing, and an arena would keep them.
+        _valueArena = (_isValueArenaEnabled && _handler == nullptr) ? ValueArena::create() : ValueArenaPtr{};
+        _tokenizer.startWithStream(inputStream, startLocation);
         parseDocument();
         _tokenizer.stop();
+        releaseValues();
         return std::exchange(_document, {});
     } catch (const Error &error) {
         _lastError = error;
+        abortParse();
+        throw;
+    } catch (std::exception&) {
+        abortParse();
+        throw;
+    }
+}
+
+
+void ParserData::beginReading(const InputStreamPtr &inputStream, ParserHandler &handler) {
+    abortParse();
+    try {
+        _handler = &handler;
+        _tokenizer.startWithStream(inputStream);
+        createDocument();
+        handler.onDocumentBegin();
+        readNextToken(); // the first token of the first statement.
+    } catch (const Error &error) {
+        _lastError = error;
+        abortParse();
+        throw;
+    } catch (std::exception&) {
+        abortParse();
+        throw;
+    }
+}
+
+
+auto ParserData::readNextStatement() -> bool {
+    try {
+        if (parseNextStatement()) {
+            return true;
+        }
         _tokenizer.stop();
-        _document = {};
+        finishDocument();
+        auto *handler = _handler;
+        abortParse();
+        handler->onDocumentEnd();
+        return false;
+    } catch (const Error &error) {
+        _lastError = error;
+        abortParse();
         throw;
     } catch (std::exception&) {
+        abortParse();
+        throw;
+    }
+}
+
+
+void ParserData::beginIncrementalParse() {
+    abortParse();
+    _valueArena = _isValueArenaEnabled ? ValueArena::create() : ValueArenaPtr{};
+    createDocument();
+}
+
+
+void ParserData::parseIncrementalPart(const InputStreamPtr &inputStream, const Location &startLocation) {
+    try {
+        _tokenizer.startWithStream(inputStream, startLocation);
+        parseStatements();
         _tokenizer.stop();
-        _document = {};
+    } catch (const Error &error) {
+        _lastError = error;
+        abortParse();
+        throw;
+    } catch (std::exception&) {
+        abortParse();
         throw;
     }
 }
 
 
+auto ParserData::finishIncrementalParse(const InputStreamPtr &inputStream, const Location &startLocation) -> ValuePtr {
+    parseIncrementalPart(inputStream, startLocation);
+    finishDocument();
+    releaseValues();
+    return std::exchange(_document, {});
+}
+
+
+void ParserData::abortParse() noexcept {
+    _tokenizer.stop();
+    releaseValues();
+    _document = {};
+    _handler = nullptr;
+}
+
+
+void ParserData::parseStream(const InputStreamPtr &inputStream, ParserHandler &handler) {
+    _handler = &handler;
+    try {
+        handler.onDocumentBegin();
+        // The returned document only contains placeholders for the values.
+        static_cast<void>(parseStream(inputStream));
+    } catch (...) {
+        _handler = nullptr;
+        throw;
+    }
+    _handler = nullptr;
+    handler.onDocumentEnd();
+}
+
+
+auto ParserData::parseSections(const InputStreamPtr &inputStream, const Location &startLocation) -> ParserSectionList {
+    _isSectionRecordEnabled = true;
+    _sections.clear();
+    try {
+        // The document is kept alive by the table of the root section.
+        static_cast<void>(parseStream(inputStream, startLocation));
+    } catch (...) {
+        _isSectionRecordEnabled = false;
+        _sections.clear();
+        throw;
+    }
+    _isSectionRecordEnabled = false;
+    return std::exchange(_sections, {});
+}
+
+
+auto ParserData::parseInParallel(const InputStreamPtr &inputStream) noexcept -> ValuePtr {
+    // Only streams with the complete data in memory can be split into chunks.
+    const auto *textStream = dynamic_cast<const TextStreamInputStream*>(inputStream.get());
+    if (textStream == nullptr) {
+        return {};
+    }
+    ParallelParser parallelParser{
+        _specification, _isValueArenaEnabled, _isValueLocationEnabled, _isLazyValueEnabled};
+    return parallelParser.parse(textStream->completeData());
+}
+
+
+void ParserData::releaseValues() noexcept {
+    _currentTable = {};
+    _currentPath.clear();
+    _placeholderValue = {};
+    _valueArena = {}; // the document shares the ownership of the arena.
+    _keyInterner.clear();
+}
+
+
+void ParserData::setValueLocation(const ValuePtr &value, const LocationRange &locationRange) noexcept {
+    if (_isValueLocationEnabled) {
+        value->setLocationRange(locationRange);
+    }
+}
+
+
+auto ParserData::createTableValue(Value::Source source) noexcept -> ValuePtr {
+    return ValueArena::createValue(_valueArena.get(), Value::Type::Table, source, Value::TableValue{});
+}
+
+
+auto ParserData::createArrayValue(Value::Source source) noexcept -> ValuePtr {
+    return ValueArena::createValue(_valueArena.get(), Value::Type::Array, source, Value::ArrayValue{});
+}
+
+
 void ParserData::parseDocument() {
+    createDocument();
+    parseStatements();
+    finishDocument();
+}
+
+
+void ParserData::createDocument() {
     // Create the root table and set it as current context.
-    _document = Value::createTable(Value::Source::ExplicitTable);
+    _document = createTableValue(Value::Source::ExplicitTable);
     _currentTable = _document;
+    if (_isSectionRecordEnabled) {
+        _sections.push_back(ParserSection{{}, false, {}, {}, _document, 0, 0});
+    }
+}
+
+
+void ParserData::parseStatements() {
     readNextToken(); // next non whitespace/comment token.
-    while (!_token.isEndOfDocument()) {
-        if (_token.isNewLine()) { // Skip all newlines
-            readNextToken();
-        } else if (_token.isKey()) {
-            parseDocumentLevelAssignment();
-        } else if (_token.type() == TokenType::TableNameBegin) {
-            parseTableName();
-        } else if (_token.type() == TokenType::ArrayNameBegin) {
-            parseArrayOfTablesName();
-        } else {
-            throwSyntaxError(QStringLiteral("Expected a table, array or assignment."));
-        }
+    while (parseNextStatement()) {
+    }
+}
+
+
+auto ParserData::parseNextStatement() -> bool {
+    while (_token.isNewLine()) { // Skip all newlines
+        _tokenizer.releaseTokenTexts(); // all values of the last statement own their texts.
+        readNextToken();
+    }
+    if (_token.isEndOfDocument()) {
+        return false;
+    }
+    if (_token.isKey()) {
+        parseDocumentLevelAssignment();
+    } else if (_token.type() == TokenType::TableNameBegin) {
+        parseTableName();
+    } else if (_token.type() == TokenType::ArrayNameBegin) {
+        parseArrayOfTablesName();
+    } else {
+        throwSyntaxError(QStringLiteral("Expected a table, array or assignment."));
     }
-    _document->setLocationRange({{}, _token.begin()}); // the whole document.
+    return true;
+}
+
+
+void ParserData::finishDocument() noexcept {
+    endSection();
+    setValueLocation(_document, {{}, _token.begin()}); // the whole document.
 }
 
 
 void ParserData::parseDocumentLevelAssignment() {
-    parseKeyValueAssignment();
+    std::vector<Token> valuePath;
+    auto value = parseKeyValueAssignment(valuePath);
     // after the value, there must be at least one newline or the end of the document.
     readNextToken();
     if (!_token.isNewLine() && !_token.isEndOfDocument()) {
         throwSyntaxError(QStringLiteral("Expected new-line after value."));
     }
+    if (_handler != nullptr) {
+        notifyAssignment(valuePath, value); // only after the whole statement was validated.
+    }
 }
 
 
-void ParserData::parseKeyValueAssignment() {
-    auto valuePath = std::vector<Token>{_token};
+auto ParserData::parseKeyValueAssignment(std::vector<Token> &valuePath) -> ValuePtr {
+    valuePath = std::vector<Token>{_token};
     auto beginLocation = _token.begin();
     readAndRequireNextToken();
     while (_token.isKeySeperator()) {
@@ -88,8 +277,13 @@ void ParserData::parseKeyValueAssignment() {
     readAndRequireNextToken(); // expect a value token next
     auto value = parseValue(); // read the next token and assume we get a value.
     auto endLocation = _token.begin();
-    value->setLocationRange({beginLocation, endLocation});
-    assignValue(valuePath, value);
+    setValueLocation(value, {beginLocation, endLocation});
+    if (_handler == nullptr) {
+        assignValue(valuePath, value);
+    } else {
+        assignValue(valuePath, createPlaceholderValue(value));
+    }
+    return value;
 }
 
 
@@ -116,6 +310,9 @@ void ParserData::parseTableName() {
     if (!_token.isNewLine() && !_token.isEndOfDocument()) {
         throwSyntaxError(QStringLiteral("Expected a new-line after the table name."));
     }
+    if (_handler != nullptr) {
+        notifyHeader(keys, false); // only after the whole statement was validated.
+    }
 }
 
 
@@ -142,16 +339,21 @@ void ParserData::parseArrayOfTablesName() {
     if (!_token.isNewLine() && !_token.isEndOfDocument()) {
         throwSyntaxError(QStringLiteral("Expected a new-line after the table name."));
     }
+    if (_handler != nullptr) {
+        notifyHeader(keys, true); // only after the whole statement was validated.
+    }
 }
 
 
 void ParserData::createTable(std::vector<Token> keys) {
+    endSection(); // before the header adds any tables.
     auto locationRange = LocationRange{keys.front().begin(), keys.back().end()};
     auto key = keys.back();
     keys.pop_back();
     auto table = createIntermediateNameElements(keys, _document, false);
-    if (table->hasKey(key.text())) {
-        auto value = table->valueFromKey(key.text());
+    const auto name = _keyInterner.intern(key.text());
+    if (table->hasKey(name)) {
+        auto value = table->valueFromKey(name);
         if (!value->isTable()) {
             throwSyntaxError(QStringLiteral("The key already exists and is no table."), key);
         }
@@ -166,22 +368,28 @@ void ParserData::createTable(std::vector<Token> keys) {
         }
         _currentTable = value;
         _currentTable->makeExplicit();
-        _currentTable->setLocationRange(locationRange); // update the location with the explicit definition.
+        setValueLocation(_currentTable, locationRange); // update the location with the explicit definition.
     } else {
-        _currentTable = Value::createTable(Value::Source::ExplicitTable);
-        _currentTable->setLocationRange(locationRange);
+        _currentTable = createTableValue(Value::Source::ExplicitTable);
+        setValueLocation(_currentTable, locationRange);
+    }
+    table->setValue(name, _currentTable);
+    keys.push_back(key); // the full path for the section.
+    if (_isSectionRecordEnabled) {
+        beginSection(keys, false);
     }
-    table->setValue(key.text(), _currentTable);
 }
 
 
 void ParserData::createArrayOfTables(std::vector<Token> keys) {
+    endSection(); // before the header adds any tables.
     auto locationRange = LocationRange{keys.front().begin(), keys.back().end()};
     auto key = keys.back();
     keys.pop_back();
     auto table = createIntermediateNameElements(keys, _document, false);
-    if (table->hasKey(key.text())) {
-        auto value = table->valueFromKey(key.text());
+    const auto name = _keyInterner.intern(key.text());
+    if (table->hasKey(name)) {
+        auto value = table->valueFromKey(name);
         if (!value->isArray()) {
             throwSyntaxError(QStringLiteral("The key exists, but is no array."), key);
         }
@@ -189,19 +397,51 @@ void ParserData::createArrayOfTables(std::vector<Token> keys) {
             throwSyntaxError(QStringLiteral("You can not extend a regular array with this syntax."), key);
         }
         // implicit and explicit tables should not exist.
-        auto newTable = Value::createTable(Value::Source::ExplicitTable);
-        newTable->setLocationRange(locationRange);
+        auto newTable = createTableValue(Value::Source::ExplicitTable);
+        setValueLocation(newTable, locationRange);
+        if (_handler != nullptr) {
+            // The following headers can only extend the last table, so the previous tables are released.
+            value = createArrayValue(Value::Source::ExplicitTable);
+            table->setValue(name, value);
+        }
         value->addValue(newTable);
         _currentTable = newTable;
     } else {
-        auto newArray = Value::createArray(Value::Source::ExplicitTable);
-        newArray->setLocationRange(locationRange);
-        table->setValue(key.text(), newArray);
-        auto newTable = Value::createTable(Value::Source::ExplicitTable);
-        newTable->setLocationRange(locationRange);
+        auto newArray = createArrayValue(Value::Source::ExplicitTable);
+        setValueLocation(newArray, locationRange);
+        table->setValue(name, newArray);
+        auto newTable = createTableValue(Value::Source::ExplicitTable);
+        setValueLocation(newTable, locationRange);
         newArray->addValue(newTable);
         _currentTable = newTable;
     }
+    keys.push_back(key); // the full path for the section.
+    if (_isSectionRecordEnabled) {
+        beginSection(keys, true);
+    }
+}
+
+
+void ParserData::beginSection(const std::vector<Token> &keys, bool isArrayOfTables) {
+    ParserSection section;
+    section.keys.reserve(keys.size());
+    for (const auto &key : keys) {
+        section.keys.push_back(_keyInterner.intern(key.text()));
+    }
+    section.isArrayOfTables = isArrayOfTables;
+    section.headerRange = LocationRange{keys.front().begin(), keys.back().end()};
+    section.implicitRange = _token.range();
+    section.table = _currentTable;
+    section.bodyBegin = _currentTable->size();
+    _sections.push_back(std::move(section));
+}
+
+
+void ParserData::endSection() noexcept {
+    if (_isSectionRecordEnabled && !_sections.empty()) {
+        auto &section = _sections.back();
+        section.bodyEnd = section.table->size();
+    }
 }
 
 
@@ -212,8 +452,9 @@ auto ParserData::createIntermediateNameElements(
 
     auto result = baseTable;
     for (const auto &key : keys) {
-        if (result->hasKey(key.text())) {
-            result = result->valueFromKey(key.text());
+        const auto name = _keyInterner.intern(key.text());
+        if (result->hasKey(name)) {
+            result = result->valueFromKey(name);
             if (result->source() == Value::Source::Value) {
                 throwSyntaxError(QStringLiteral("A dotted key must not point to an existing value."));
             }
@@ -236,13 +477,18 @@ auto ParserData::createIntermediateNameElements(
                 if (isValueAssignment && (result->source() == Value::Source::ImplicitTable || result->source() == Value::Source::ExplicitTable)) {
                     throwSyntaxError(QStringLiteral("A dotted key of a value must not point to explicitly defined tables."));
                 }
+                if (!isValueAssignment && _isSectionRecordEnabled
+                    && (result->source() == Value::Source::ImplicitValue || result->source() == Value::Source::ExplicitValue)) {
+                    // The merge of the sections only moves the values of the assignments, and would miss this table.
+                    throwSyntaxError(QStringLiteral("A table header extends a table of a dotted key in a separately parsed chunk."));
+                }
             }
         } else {
             // If the key does not exist, create a new table for the value or structure.
-            auto newTable = Value::createTable(
+            auto newTable = createTableValue(
                 isValueAssignment ? Value::Source::ImplicitValue : Value::Source::ImplicitTable);
-            newTable->setLocationRange(_token.range());
-            result->setValue(key.text(), newTable);
+            setValueLocation(newTable, _token.range());
+            result->setValue(name, newTable);
             result = newTable;
         }
     }
@@ -258,24 +504,22 @@ auto ParserData::parseValue() -> ValuePtr {
         return parseArrayValue();
     case TokenType::SingleLineString:
     case TokenType::MultiLineString:
-        return Value::createString(_token.text());
+        return createValue(Value::Type::String, _token.text().toString());
     case TokenType::Boolean:
-        return Value::createBoolean(_token.text() == "true");
+        return createValue(Value::Type::Boolean, _token.text() == QLatin1String("true"));
     case TokenType::DecimalInteger:
         return parseIntegerValue();
     case TokenType::HexInteger:
-        return Value::createInteger(QStringView{_token.text()}.mid(2).toLongLong(nullptr, 16));
     case TokenType::BinaryInteger:
-        return Value::createInteger(QStringView{_token.text()}.mid(2).toLongLong(nullptr, 2));
     case TokenType::OctalInteger:
-        return Value::createInteger(QStringView{_token.text()}.mid(2).toLongLong(nullptr, 8));
+        return createIntegerValue();
     case TokenType::Float:
         return parseFloatValue();
     case TokenType::OffsetDateTime:
     case TokenType::LocalDateTime:
         return parseDateTimeValue();
     case TokenType::LocalDate:
-        return Value::createDate(QDate::fromString(_token.text(), Qt::ISODate));
+        return createScalarValue(Value::Type::Date);
     case TokenType::LocalTime:
         return parseTimeValue();
     default:
@@ -286,120 +530,82 @@ auto ParserData::parseValue() -> ValuePtr {
 
 auto ParserData::parseIntegerValue() -> ValuePtr {
     // Make sure the integer does not start with a zero
-    auto text = QStringView(_token.text());
+    auto text = _token.text();
     if (text.startsWith('+') || text.startsWith('-')) {
         text = text.mid(1);
     }
     if (text != QStringLiteral("0") && text.startsWith('0')) {
         throwSyntaxError(QStringLiteral("Leading zeros are not allowed for integer values."));
     }
-    return Value::createInteger(_token.text().toLongLong());
+    return createIntegerValue();
+}
+
+
+auto ParserData::createIntegerValue() -> ValuePtr {
+    bool ok;
+    const auto value = ScalarConverter::toInteger(_token.text(), &ok);
+    if (!ok) {
+        throwSyntaxError(QStringLiteral("The integer value does not fit into a signed 64-bit integer."));
+    }
+    return createValue(Value::Type::Integer, value);
 }
 
 
 auto ParserData::parseFloatValue() -> ValuePtr {
     // Make sure the float does not start with a zero.
-    auto text = QStringView(_token.text());
+    auto text = _token.text();
     if (text.startsWith('+') || text.startsWith('-')) {
         text = text.mid(1);
     }
-    if (text.compare(QStringLiteral("nan"), Qt::CaseInsensitive) == 0) {
-        // as there is no negative nan and Qt does a poor job parsing it, create the nan manually.
-        return Value::createFloat(std::numeric_limits<double>::quiet_NaN());
-    }
-    if (!(text.startsWith(QStringLiteral("0.")) || text.startsWith(QStringLiteral("0e"), Qt::CaseInsensitive))) {
+    if (text.compare(QStringLiteral("nan"), Qt::CaseInsensitive) != 0
+        && !(text.startsWith(QStringLiteral("0.")) || text.startsWith(QStringLiteral("0e"), Qt::CaseInsensitive))) {
         if (text.startsWith('0')) {
             throwSyntaxError(QStringLiteral("Leading zeros are not allowed for floating point values."));
         }
     }
-    return Value::createFloat(_token.text().toDouble());
+    return createScalarValue(Value::Type::Float);
 }
 
 
 auto ParserData::parseTimeValue() -> ValuePtr {
-    auto text = QStringView(_token.text());
-    auto [time, timeSpec, offset] = convertTime(text);
-    return Value::createTime(time);
+    if (const auto errorMessage = ScalarConverter::timeError(_token.dateTimeFields()); !errorMessage.isEmpty()) {
+        throwSyntaxError(errorMessage);
+    }
+    return createScalarValue(Value::Type::Time);
 }
 
 
 auto ParserData::parseDateTimeValue() -> ValuePtr {
-    auto text = QStringView(_token.text());
-    auto date = convertDate(text.left(10));
-    auto [time, timeSpec, offset] = convertTime(text.mid(11));
-    auto dateTime = QDateTime{date, time, timeSpec, offset};
-    return Value::createDateTime(dateTime);
-}
-
-
-auto ParserData::convertDate(const QStringView &text) -> QDate {
-    auto date = QDate::fromString(text.toString(), Qt::ISODate);
-    if (!date.isValid()) {
-        throwSyntaxError(QStringLiteral("The date/time value is not valid. Invalid date."));
+    if (const auto errorMessage = ScalarConverter::dateTimeError(_token.dateTimeFields()); !errorMessage.isEmpty()) {
+        throwSyntaxError(errorMessage);
     }
-    return date;
+    return createScalarValue(Value::Type::DateTime);
 }
 
 
-auto ParserData::convertTime(const QStringView &text) -> std::tuple<QTime, Qt::TimeSpec, int> {
-    qsizetype offsetSeconds = 0;
-    qsizetype offsetIndex = -1;
-    bool hasOffset = false;
-    int fractionMilliseconds = 0;
-    if (text.endsWith('z', Qt::CaseInsensitive)) {
-        hasOffset = true;
-        offsetIndex = text.size() - 1;
-    } else {
-        offsetIndex = std::max(text.indexOf('-'), text.indexOf('+'));
-        if (offsetIndex >= 0) {
-            hasOffset = true;
-            auto offsetHour = text.mid(offsetIndex + 1, 2).toInt();
-            if (offsetHour >= 24) {
-                throwSyntaxError(QStringLiteral("The time value is not valid. Offset hour is not valid."));
-            }
-            auto offsetMinute = text.mid(offsetIndex + 4, 2).toInt();
-            if (offsetMinute >= 60) {
-                throwSyntaxError(QStringLiteral("The time value is not valid. Offset minute is not valid."));
-            }
-            offsetSeconds = 3600 * offsetHour + 60 * offsetMinute;
-            if (text[offsetIndex] == '-') {
-                offsetSeconds *= -1;
-            }
+auto ParserData::createScalarValue(Value::Type type) -> ValuePtr {
+    const auto text = _token.text();
+    if (_isLazyValueEnabled) {
+        if (auto value = ValueArena::createScalarTextValue(_valueArena.get(), type, text); value != nullptr) {
+            return value;
         }
     }
-    auto fractionIndex = text.indexOf('.');
-    if (fractionIndex >= 0) {
-        qsizetype fractionLength = 3;
-        if (offsetIndex >= 0) {
-            fractionLength = std::min(offsetIndex - (fractionIndex + 1), static_cast<qsizetype>(3));
-        }
-        fractionMilliseconds = text.mid(fractionIndex + 1, fractionLength)
-            .toString().leftJustified(3, QChar('0')).toInt();
-    }
-    auto timeLength = (fractionIndex >= 0) ? fractionIndex : ((offsetIndex >= 0) ? offsetIndex : text.size());
-    auto timeParts = text.left(timeLength).split(':');
-    auto hour = timeParts.value(0).toInt();
-    auto minute = timeParts.value(1).toInt();
-    auto second = timeParts.value(2).toInt();
-    if (hour > 23) {
-        throwSyntaxError(QStringLiteral("The time value is not valid. Hour exceeds 23."));
-    }
-    if (minute > 59) {
-        throwSyntaxError(QStringLiteral("The time value is not valid. Minute exceeds 59."));
-    }
-    if (second > 59) {
-        throwSyntaxError(QStringLiteral("The time value is not valid. Second exceeds 59."));
+    switch (type) {
+    case Value::Type::Float:
+        return createValue(type, ScalarConverter::toFloat(text));
+    case Value::Type::Time:
+    case Value::Type::Date:
+    case Value::Type::DateTime:
+        return createValue(type, ScalarConverter::toTimestamp(type, _token.dateTimeFields()));
+    default:
+        throw std::logic_error("Unexpected type for a scalar value.");
     }
-    return std::make_tuple(
-        QTime{hour, minute, second, fractionMilliseconds},
-        !hasOffset ? Qt::LocalTime : ((offsetSeconds == 0) ? Qt::UTC : Qt::OffsetFromUTC),
-        offsetSeconds);
 }
 
 
 auto ParserData::parseArrayValue() -> ValuePtr {
     auto beginArrayLocation = _token.begin();
-    auto array = Value::createArray(Value::Source::Value);
+    auto array = createArrayValue(Value::Source::Value);
     readAndRequireNextToken(); // Expect a value or array end.
     while (_token.type() != TokenType::ArrayEnd) {
         if (_token.isNewLine()) {
@@ -409,7 +615,7 @@ auto ParserData::parseArrayValue() -> ValuePtr {
         auto beginValueLocation = _token.begin();
         auto value = parseValue();
         auto endValueLocation = _token.begin(); // not prefect
-        value->setLocationRange({beginValueLocation, endValueLocation});
+        setValueLocation(value, {beginValueLocation, endValueLocation});
         array->addValue(value);
         readAndRequireNextToken(); // Expect a value separator, value, or array end.
         while (_token.isNewLine()) { // Skip any number of newlines after the value.
@@ -421,14 +627,14 @@ auto ParserData::parseArrayValue() -> ValuePtr {
             throwSyntaxError(QStringLiteral("Expected a value separator or the end of the array."));
         }
     }
-    array->setLocationRange({beginArrayLocation, _token.end()});
+    setValueLocation(array, {beginArrayLocation, _token.end()});
     return array;
 }
 
 
 auto ParserData::parseInlineTableValue() -> ValuePtr {
     auto beginTableLocation = _token.begin();
-    auto table = Value::createTable(Value::Source::Value);
+    auto table = createTableValue(Value::Source::Value);
     readAndRequireNextToken(); // Expect a name or the end of the table.
     while (_token.type() != TokenType::TableEnd) {
         if (_token.isNewLine()) {
@@ -460,15 +666,16 @@ auto ParserData::parseInlineTableValue() -> ValuePtr {
         readAndRequireNextToken();
         auto value = parseValue();
         auto endAssignmentLocation = _token.begin();
-        value->setLocationRange({beginAssignmentLocation, endAssignmentLocation});
+        setValueLocation(value, {beginAssignmentLocation, endAssignmentLocation});
         // Assign this value.
         auto key = keys.back();
         keys.pop_back();
         auto tableInContext = createIntermediateNameElements(keys, table, true);
-        if (tableInContext->hasKey(key.text())) {
+        const auto name = _keyInterner.intern(key.text());
+        if (tableInContext->hasKey(name)) {
             throwSyntaxError(QStringLiteral("A key with this name already exists in this inline table."));
         }
-        tableInContext->setValue(key.text(), value);
+        tableInContext->setValue(name, value);
         readAndRequireNextToken(); // Expect a value separator, value, or array end.
         if (_specification >= Specification::Version_1_1) {
             while (_token.isNewLine()) {
@@ -484,27 +691,92 @@ auto ParserData::parseInlineTableValue() -> ValuePtr {
             throwSyntaxError(QStringLiteral("Expected a value separator or the end of the inline table."));
         }
     }
-    table->setLocationRange({beginTableLocation, _token.end()});
+    setValueLocation(table, {beginTableLocation, _token.end()});
     return table;
 }
 
 
+auto ParserData::createPlaceholderValue(const ValuePtr &value) noexcept -> ValuePtr {
+    if (value->isTable()) {
+        return createTableValue(Value::Source::Value);
+    }
+    if (value->isArray()) {
+        return createArrayValue(Value::Source::Value);
+    }
+    if (_placeholderValue == nullptr) {
+        _placeholderValue = createValue(Value::Type::Boolean, false);
+    }
+    return _placeholderValue;
+}
+
+
+void ParserData::notifyHeader(const std::vector<Token> &keys, bool isArrayOfTables) {
+    _currentPath.clear();
+    for (const auto &key : keys) {
+        _currentPath.append(_keyInterner.intern(key.text()));
+    }
+    const auto path = KeyPath{_currentPath};
+    if (isArrayOfTables) {
+        _handler->onArrayOfTables(path);
+    } else {
+        _handler->onTable(path);
+    }
+}
+
+
+void ParserData::notifyAssignment(const std::vector<Token> &keys, const ValuePtr &value) {
+    auto path = _currentPath;
+    for (const auto &key : keys) {
+        path.append(_keyInterner.intern(key.text()));
+    }
+    notifyValue(path, value);
+}
+
+
+void ParserData::notifyValue(QStringList &path, const ValuePtr &value) {
+    if (value->isArray()) {
+        const auto keyPath = KeyPath{path};
+        _handler->onArrayBegin(keyPath);
+        for (const auto &element : value->toArrayRef()) {
+            notifyValue(path, element);
+        }
+        _handler->onArrayEnd(keyPath);
+    } else if (value->isTable()) {
+        // Tables created by dotted keys in an inline table are part of the path, and have no events.
+        const bool isInlineTable = (value->source() == Value::Source::Value);
+        const auto keyPath = KeyPath{path};
+        if (isInlineTable) {
+            _handler->onInlineTableBegin(keyPath);
+        }
+        for (const auto &[key, entryValue] : value->toTableRef()) {
+            path.append(key);
+            notifyValue(path, entryValue);
+            path.removeLast();
+        }
+        if (isInlineTable) {
+            _handler->onInlineTableEnd(keyPath);
+        }
+    } else {
+        _handler->onKeyValue(KeyPath{path}, value);
+    }
+}
+
+
 void ParserData::assignValue(std::vector<Token> keys, const ValuePtr &value) {
     auto key = keys.back();
     keys.pop_back();
     auto table = createIntermediateNameElements(keys, _currentTable, true);
-    if (table->hasKey(key.text())) {
+    const auto name = _keyInterner.intern(key.text()); // interned keys are compared by their data first.
+    if (table->hasKey(name)) {
         throwSyntaxError(QStringLiteral("A value with the given name already exists."), key);
     }
-    table->setValue(key.text(), value);
+    table->setValue(name, value);
     table->makeExplicit();
 }
 
 
 void ParserData::readNextToken() {
-    do {
-        _token = _tokenizer.read();
-    } while (_token.type() == TokenType::Whitespace || _token.type() == TokenType::Comment);
+    _token = _tokenizer.read(); // whitespace and comments are skipped by the tokenizer.
 }
 
 
@@ -4,9 +4,13 @@
 #pragma once
 
 
+#include "KeyInterner.hpp"
+#include "ParserSection.hpp"
 #include "Tokenizer.hpp"
 #include "Token.hpp"
+#include "ValueArena.hpp"
 
+#include "../ParserHandler.hpp"
 #include "../Specification.hpp"
 #include "../Value.hpp"
 
@@ -36,22 +40,175 @@ public:
     /// This function reads and parses data from the given input stream.
     ///
     /// @param inputStream The input stream.
+    /// @param startLocation The location of the first character in the stream.
     /// @return A value that contains the parsed TOML data. This is always the special *root table*.
     /// @throws Error from the stream implementation and on any problem with the data.
     ///
-    [[nodiscard]] auto parseStream(const InputStreamPtr &inputStream) -> ValuePtr;
+    [[nodiscard]] auto parseStream(const InputStreamPtr &inputStream, const Location &startLocation = {}) -> ValuePtr;
+
+    /// Parse TOML data from an input stream and send its contents to a handler.
+    ///
+    /// @param inputStream The input stream.
+    /// @param handler The handler for the events.
+    /// @throws Error from the stream implementation and on any problem with the data.
+    ///
+    void parseStream(const InputStreamPtr &inputStream, ParserHandler &handler);
+
+    /// Parse a chunk of a document and record its sections.
+    ///
+    /// Table headers that extend a table created by a dotted key of a value assignment are rejected,
+    /// as the sections of such a chunk can not be merged.
+    ///
+    /// @param inputStream The input stream with the chunk.
+    /// @param startLocation The location of the first character of the chunk in the document.
+    /// @return The sections of the chunk in document order, starting with the root section.
+    /// @throws Error from the stream implementation and on any problem with the data.
+    ///
+    [[nodiscard]] auto parseSections(const InputStreamPtr &inputStream, const Location &startLocation) -> ParserSectionList;
+
+    /// Start to read a document statement by statement.
+    ///
+    /// @param inputStream The input stream.
+    /// @param handler The handler for the events.
+    /// @throws Error from the stream implementation and on any problem with the data.
+    ///
+    void beginReading(const InputStreamPtr &inputStream, ParserHandler &handler);
+
+    /// Read the next statement of the document.
+    ///
+    /// @return `true` if a statement was read, `false` at the end of the document.
+    /// @throws Error from the stream implementation and on any problem with the data.
+    ///
+    [[nodiscard]] auto readNextStatement() -> bool;
+
+    /// Start to parse a document that is received in parts.
+    ///
+    void beginIncrementalParse();
+
+    /// Parse the next part of a document.
+    ///
+    /// The part must end after a complete statement, after a newline at the top level of the document.
+    ///
+    /// @param inputStream The input stream with the part.
+    /// @param startLocation The location of the first character of the part in the document.
+    /// @throws Error on any problem with the data. The parsed values are released in this case.
+    ///
+    void parseIncrementalPart(const InputStreamPtr &inputStream, const Location &startLocation);
+
+    /// Parse the last part of a document and finish the document.
+    ///
+    /// @param inputStream The input stream with the last part.
+    /// @param startLocation The location of the first character of the part in the document.
+    /// @return The parsed document.
+    /// @throws Error on any problem with the data.
+    ///
+    [[nodiscard]] auto finishIncrementalParse(const InputStreamPtr &inputStream, const Location &startLocation) -> ValuePtr;
+
+    /// Stop parsing and release the current document.
+    ///
+    void abortParse() noexcept;
+
+    /// Set if the values of parsed documents are allocated in a value arena.
+    ///
+    inline void setValueArenaEnabled(bool enabled) noexcept {
+        _isValueArenaEnabled = enabled;
+    }
+
+    /// Set if the location ranges are stored in the values.
+    ///
+    inline void setValueLocationEnabled(bool enabled) noexcept {
+        _isValueLocationEnabled = enabled;
+    }
+
+    /// Set if the float, date and time values are converted on the first access.
+    ///
+    inline void setLazyValuesEnabled(bool enabled) noexcept {
+        _isLazyValueEnabled = enabled;
+    }
+
+    /// Set if files are mapped into memory for parsing.
+    ///
+    inline void setFileMappingEnabled(bool enabled) noexcept {
+        _isFileMappingEnabled = enabled;
+    }
+
+    /// Test if files are mapped into memory for parsing.
+    ///
+    [[nodiscard]] inline auto isFileMappingEnabled() const noexcept -> bool {
+        return _isFileMappingEnabled;
+    }
+
+    /// Set if large documents with complete data are parsed in parallel.
+    ///
+    inline void setParallelParsingEnabled(bool enabled) noexcept {
+        _isParallelParsingEnabled = enabled;
+    }
+
+    /// Try to parse a large document in parallel.
+    ///
+    /// @param inputStream The input stream.
+    /// @return The parsed document, or `nullptr` if the document has to be parsed sequentially.
+    ///
+    [[nodiscard]] auto parseInParallel(const InputStreamPtr &inputStream) noexcept -> ValuePtr;
+
+    /// Release all values that are held by the parser after parsing.
+    ///
+    void releaseValues() noexcept;
+
+    /// Set the location range of a value, if this is enabled.
+    ///
+    void setValueLocation(const ValuePtr &value, const LocationRange &locationRange) noexcept;
+
+    /// Create a new table value, in the value arena if it is enabled.
+    ///
+    [[nodiscard]] auto createTableValue(Value::Source source) noexcept -> ValuePtr;
+
+    /// Create a new array value, in the value arena if it is enabled.
+    ///
+    [[nodiscard]] auto createArrayValue(Value::Source source) noexcept -> ValuePtr;
+
+    /// Create a new regular value, in the value arena if it is enabled.
+    ///
+    /// @param type The type of the value.
+    /// @param value The value, that must have the exact type that is stored for `type`.
+    ///
+    template<typename T>
+    [[nodiscard]] auto createValue(Value::Type type, T value) noexcept -> ValuePtr {
+        return ValueArena::createValue(_valueArena.get(), type, Value::Source::Value, std::move(value));
+    }
 
     /// Parse the tokens from the tokenizer.
     ///
     void parseDocument();
 
+    /// Create the root table of a new document.
+    ///
+    void createDocument();
+
+    /// Parse all statements until the end of the input.
+    ///
+    void parseStatements();
+
+    /// Parse the next statement.
+    ///
+    /// @return `true` if a statement was parsed, `false` at the end of the input.
+    ///
+    [[nodiscard]] auto parseNextStatement() -> bool;
+
+    /// Finish the document after the last statement.
+    ///
+    void finishDocument() noexcept;
+
     /// Parse an assignment on the document level.
     ///
     void parseDocumentLevelAssignment();
 
     /// Parse a key = value assignment on the document level or in a local table.
     ///
-    void parseKeyValueAssignment();
+    /// @param valuePath Receives the keys of the assignment.
+    /// @return The assigned value.
+    ///
+    [[nodiscard]] auto parseKeyValueAssignment(std::vector<Token> &valuePath) -> ValuePtr;
 
     /// Parse a table name.
     ///
@@ -89,13 +246,20 @@ public:
     ///
     [[nodiscard]] auto parseDateTimeValue() -> ValuePtr;
 
-    /// Verify and convert a date text.
+    /// Create the value for the current integer token.
     ///
-    [[nodiscard]] auto convertDate(const QStringView &text) -> QDate;
+    /// Integers are always converted while parsing, as the conversion detects integers that do not fit.
+    ///
+    [[nodiscard]] auto createIntegerValue() -> ValuePtr;
 
-    /// Verify and convert a time text.
+    /// Create the value for the current float, date or time token.
+    ///
+    /// If lazy values are enabled, the text of the token is stored in the value, and converted on the
+    /// first access. Otherwise, the text is converted immediately.
+    ///
+    /// @param type The type of the value.
     ///
-    [[nodiscard]] auto convertTime(const QStringView &text) -> std::tuple<QTime, Qt::TimeSpec, int>;
+    [[nodiscard]] auto createScalarValue(Value::Type type) -> ValuePtr;
 
     /// Parse an array.
     ///
@@ -143,6 +307,45 @@ public:
         const ValuePtr &baseTable,
         bool isValueAssignment) -> ValuePtr;
 
+    /// Start a new section after a table or array of tables header.
+    ///
+    /// @param keys The vector with names tokens of the header.
+    /// @param isArrayOfTables If the header is for an array of tables.
+    ///
+    void beginSection(const std::vector<Token> &keys, bool isArrayOfTables);
+
+    /// Close the current section, if sections are recorded.
+    ///
+    void endSection() noexcept;
+
+    /// Create the placeholder for an assigned value, that is stored in the document if a handler is used.
+    ///
+    /// The placeholder has the same type category and source as the value, which is sufficient to validate
+    /// the following statements.
+    ///
+    [[nodiscard]] auto createPlaceholderValue(const ValuePtr &value) noexcept -> ValuePtr;
+
+    /// Send a table or array of tables header to the handler.
+    ///
+    /// @param keys The vector with names tokens of the header.
+    /// @param isArrayOfTables If the header is for an array of tables.
+    ///
+    void notifyHeader(const std::vector<Token> &keys, bool isArrayOfTables);
+
+    /// Send an assigned value to the handler.
+    ///
+    /// @param keys The vector with names tokens of the assignment, relative to the current table.
+    /// @param value The assigned value.
+    ///
+    void notifyAssignment(const std::vector<Token> &keys, const ValuePtr &value);
+
+    /// Send a value and all values it contains to the handler.
+    ///
+    /// @param path The path of the value, which is restored on return.
+    /// @param value The value.
+    ///
+    void notifyValue(QStringList &path, const ValuePtr &value);
+
     /// Try to assign a value to the current container.
     ///
     /// @param keys The vector with names tokens.
@@ -172,6 +375,18 @@ private:
     Token _token{}; ///< The current token.
     ValuePtr _document{}; ///< The current document.
     ValuePtr _currentTable{}; ///< The current table.
+    bool _isValueArenaEnabled{false}; ///< If the values are allocated in a value arena.
+    bool _isValueLocationEnabled{true}; ///< If the location ranges are stored in the values.
+    bool _isLazyValueEnabled{false}; ///< If scalar values are converted on the first access.
+    bool _isFileMappingEnabled{false}; ///< If files are mapped into memory for parsing.
+    bool _isParallelParsingEnabled{false}; ///< If large documents are parsed in parallel.
+    bool _isSectionRecordEnabled{false}; ///< If the sections of the document are recorded.
+    ParserSectionList _sections{}; ///< The recorded sections of the current document.
+    ParserHandler *_handler{}; ///< The handler for the events, or `nullptr` to build the document.
+    QStringList _currentPath{}; ///< The path of the current table, if a handler is used.
+    ValuePtr _placeholderValue{}; ///< The placeholder for regular values, if a handler is used.
+    ValueArenaPtr _valueArena{}; ///< The value arena for the current document.
+    KeyInterner _keyInterner{}; ///< The shared keys of the current document.
     Error _lastError{}; ///< The last error from one of the parse method calls.
 };
 
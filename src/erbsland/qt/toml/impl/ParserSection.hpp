@@ -0,0 +1,43 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "../LocationRange.hpp"
+#include "../Value.hpp"
+
+#include <QtCore/QString>
+
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// The record of one section of a parsed document.
+///
+/// A section starts with a table or array of tables header, and contains all assignments up to the next
+/// header. The first section of a document contains the assignments of the root table and has no keys.
+/// The records are used to merge documents that were parsed in separate chunks.
+///
+struct ParserSection {
+    std::vector<QString> keys; ///< The keys of the header, or an empty list for the root section.
+    bool isArrayOfTables{false}; ///< If the header is for an array of tables.
+    LocationRange headerRange{}; ///< The location range of the keys in the header.
+    LocationRange implicitRange{}; ///< The location range of implicitly created tables.
+    ValuePtr table{}; ///< The table that got the assignments of this section.
+    std::size_t bodyBegin{}; ///< The index of the first entry in `table` that was assigned in this section.
+    std::size_t bodyEnd{}; ///< The index after the last entry in `table` that was assigned in this section.
+};
+
+
+/// @private
+/// The list of sections of a document.
+///
+using ParserSectionList = std::vector<ParserSection>;
+
+
+}
+
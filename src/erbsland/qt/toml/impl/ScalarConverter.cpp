@@ -0,0 +1,266 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ScalarConverter.hpp"
+
+
+#include <QtCore/QDate>
+
+#include <array>
+#include <limits>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+auto ScalarConverter::timeError(const DateTimeFields &fields) noexcept -> QString {
+    if (fields.offsetHour >= 24) {
+        return QStringLiteral("The time value is not valid. Offset hour is not valid.");
+    }
+    if (fields.offsetMinute >= 60) {
+        return QStringLiteral("The time value is not valid. Offset minute is not valid.");
+    }
+    if (fields.hour > 23) {
+        return QStringLiteral("The time value is not valid. Hour exceeds 23.");
+    }
+    if (fields.minute > 59) {
+        return QStringLiteral("The time value is not valid. Minute exceeds 59.");
+    }
+    if (fields.second > 59) {
+        return QStringLiteral("The time value is not valid. Second exceeds 59.");
+    }
+    return {};
+}
+
+
+auto ScalarConverter::dateTimeError(const DateTimeFields &fields) noexcept -> QString {
+    if (!QDate::isValid(fields.year, fields.month, fields.day)) {
+        return QStringLiteral("The date/time value is not valid. Invalid date.");
+    }
+    return timeError(fields);
+}
+
+
+auto ScalarConverter::toInteger(QStringView text, bool *ok) noexcept -> int64_t {
+    uint64_t base = 10;
+    bool isNegative = false;
+    qsizetype index = 0;
+    if (text.size() > 2 && text[0] == QChar('0') && (text[1] == QChar('x') || text[1] == QChar('o') || text[1] == QChar('b'))) {
+        base = (text[1] == QChar('x')) ? 16 : ((text[1] == QChar('o')) ? 8 : 2);
+        index = 2;
+    } else if (!text.isEmpty() && (text[0] == QChar('+') || text[0] == QChar('-'))) {
+        isNegative = (text[0] == QChar('-'));
+        index = 1;
+    }
+    // The magnitude of the smallest negative integer is one larger than the largest positive integer.
+    const auto limit = static_cast<uint64_t>(std::numeric_limits<int64_t>::max()) + (isNegative ? 1U : 0U);
+    uint64_t value = 0;
+    for (; index < text.size(); ++index) {
+        const auto c = text[index].unicode();
+        uint64_t digit;
+        if (c >= u'0' && c <= u'9') {
+            digit = c - u'0';
+        } else if (c >= u'a' && c <= u'f') {
+            digit = c - u'a' + 10;
+        } else {
+            digit = c - u'A' + 10;
+        }
+        if (value > (limit - digit) / base) {
+            *ok = false;
+            return 0;
+        }
+        value = value * base + digit;
+    }
+    *ok = true;
+    if (isNegative) {
+        // Negate in the unsigned range, which also works for the smallest integer.
+        return static_cast<int64_t>(~value + 1U);
+    }
+    return static_cast<int64_t>(value);
+}
+
+
+auto ScalarConverter::toFloat(QStringView text) noexcept -> double {
+    auto unsignedText = text;
+    bool isNegative = false;
+    if (unsignedText.startsWith('+') || unsignedText.startsWith('-')) {
+        isNegative = unsignedText.startsWith('-');
+        unsignedText = unsignedText.mid(1);
+    }
+    if (unsignedText.compare(QStringLiteral("nan"), Qt::CaseInsensitive) == 0) {
+        // as there is no negative nan and Qt does a poor job parsing it, create the nan manually.
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    if (unsignedText.compare(QStringLiteral("inf"), Qt::CaseInsensitive) == 0) {
+        return isNegative ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+    }
+    double result;
+    if (toFloatExactly(unsignedText, result)) {
+        return isNegative ? -result : result;
+    }
+    return text.toDouble();
+}
+
+
+auto ScalarConverter::toTimestamp(ValueType type, const DateTimeFields &fields) noexcept -> Timestamp {
+    const auto date = QDate{fields.year, fields.month, fields.day};
+    const auto julianDay = date.isValid() ? date.toJulianDay() : Timestamp::cNoDate;
+    const auto seconds = (static_cast<int64_t>(fields.hour) * 60 + fields.minute) * 60 + fields.second;
+    const auto nanosecondsOfDay = seconds * INT64_C(1000000000) + fields.nanosecond;
+    switch (type) {
+    case ValueType::Time:
+        return Timestamp{Timestamp::Kind::LocalTime, Timestamp::cNoDate, nanosecondsOfDay};
+    case ValueType::Date:
+        return Timestamp{Timestamp::Kind::LocalDate, julianDay, Timestamp::cNoTime};
+    default:
+        if (fields.hasOffset) {
+            return Timestamp{Timestamp::Kind::OffsetDateTime, julianDay, nanosecondsOfDay, fields.offsetSeconds()};
+        }
+        return Timestamp{Timestamp::Kind::LocalDateTime, julianDay, nanosecondsOfDay};
+    }
+}
+
+
+auto ScalarConverter::toTimestamp(ValueType type, QStringView text) noexcept -> Timestamp {
+    DateTimeFields fields;
+    switch (type) {
+    case ValueType::Time:
+        readTimeFields(text, fields);
+        break;
+    case ValueType::Date:
+        readDateFields(text, fields);
+        break;
+    default:
+        readDateFields(text, fields);
+        readTimeFields(text.mid(11), fields);
+        break;
+    }
+    return toTimestamp(type, fields);
+}
+
+
+void ScalarConverter::readDateFields(QStringView text, DateTimeFields &fields) noexcept {
+    fields.year = static_cast<uint16_t>(digitsValue(text, 0, 4));
+    fields.month = static_cast<uint8_t>(digitsValue(text, 5, 2));
+    fields.day = static_cast<uint8_t>(digitsValue(text, 8, 2));
+}
+
+
+void ScalarConverter::readTimeFields(QStringView text, DateTimeFields &fields) noexcept {
+    fields.hour = static_cast<uint8_t>(digitsValue(text, 0, 2));
+    fields.minute = static_cast<uint8_t>(digitsValue(text, 3, 2));
+    qsizetype index = 5;
+    if (index < text.size() && text[index] == QChar(':')) {
+        fields.second = static_cast<uint8_t>(digitsValue(text, index + 1, 2));
+        index += 3;
+    }
+    if (index < text.size() && text[index] == QChar('.')) {
+        index += 1;
+        int fractionDigits = 0;
+        uint32_t nanosecond = 0;
+        for (; index < text.size() && text[index] >= QChar('0') && text[index] <= QChar('9'); ++index) {
+            if (fractionDigits < 9) {
+                nanosecond = nanosecond * 10U + static_cast<uint32_t>(text[index].unicode() - u'0');
+                fractionDigits += 1;
+            }
+        }
+        for (; fractionDigits < 9; ++fractionDigits) {
+            nanosecond *= 10U;
+        }
+        fields.nanosecond = nanosecond;
+    }
+    if (index < text.size()) {
+        fields.hasOffset = true;
+        if (text[index] == QChar('+') || text[index] == QChar('-')) {
+            fields.isNegativeOffset = (text[index] == QChar('-'));
+            fields.offsetHour = static_cast<uint8_t>(digitsValue(text, index + 1, 2));
+            fields.offsetMinute = static_cast<uint8_t>(digitsValue(text, index + 4, 2));
+        }
+    }
+}
+
+
+auto ScalarConverter::toFloatExactly(QStringView text, double &result) noexcept -> bool {
+    // The powers of ten, that are exactly representable as double.
+    static constexpr std::array<double, 23> cPowersOfTen = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    // The largest integer, up to which all integers are exactly representable as double.
+    constexpr uint64_t cMaximumExactMantissa = uint64_t{1} << 53;
+    // The number of digits that always fit into the 64-bit mantissa.
+    constexpr int cMaximumDigits = 19;
+
+    uint64_t mantissa = 0;
+    int digitCount = 0;
+    int exponent = 0;
+    qsizetype index = 0;
+    bool isFraction = false;
+    for (; index < text.size(); ++index) {
+        const auto c = text[index].unicode();
+        if (c == u'.') {
+            isFraction = true;
+            continue;
+        }
+        if (c < u'0' || c > u'9') {
+            break;
+        }
+        if (mantissa == 0 && c == u'0') {
+            if (isFraction) {
+                exponent -= 1; // leading zeros of the fraction only shift the exponent.
+            }
+            continue;
+        }
+        if (digitCount == cMaximumDigits) {
+            return false;
+        }
+        mantissa = mantissa * 10 + (c - u'0');
+        digitCount += 1;
+        if (isFraction) {
+            exponent -= 1;
+        }
+    }
+    if (index < text.size()) { // the exponent, after `e` or `E`.
+        index += 1;
+        bool isNegativeExponent = false;
+        if (text[index] == QChar('+') || text[index] == QChar('-')) {
+            isNegativeExponent = (text[index] == QChar('-'));
+            index += 1;
+        }
+        int exponentValue = 0;
+        for (; index < text.size(); ++index) {
+            if (exponentValue > 10000) {
+                return false; // far out of range, leave the special cases to the full conversion.
+            }
+            exponentValue = exponentValue * 10 + (text[index].unicode() - u'0');
+        }
+        exponent += isNegativeExponent ? -exponentValue : exponentValue;
+    }
+    if (mantissa == 0) {
+        result = 0.0;
+        return true;
+    }
+    if (mantissa > cMaximumExactMantissa || exponent < -22 || exponent > 22) {
+        return false;
+    }
+    // Both operands are exact, so the result is rounded only once, like the exact decimal value.
+    const auto value = static_cast<double>(mantissa);
+    if (exponent < 0) {
+        result = value / cPowersOfTen[static_cast<std::size_t>(-exponent)];
+    } else {
+        result = value * cPowersOfTen[static_cast<std::size_t>(exponent)];
+    }
+    return true;
+}
+
+
+auto ScalarConverter::digitsValue(QStringView text, qsizetype index, qsizetype count) noexcept -> int {
+    int result = 0;
+    for (auto i = index; i < index + count && i < text.size(); ++i) {
+        result = result * 10 + (text[i].unicode() - u'0');
+    }
+    return result;
+}
+
+
+}
+
@@ -0,0 +1,112 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "DateTimeFields.hpp"
+
+#include "../Timestamp.hpp"
+#include "../ValueType.hpp"
+
+#include <QtCore/QString>
+#include <QtCore/QStringView>
+
+#include <cstdint>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// The conversion of the text of scalar tokens into values.
+///
+/// The conversion functions expect the text or the numbers of a token, as they were read by the tokenizer,
+/// and do not report any errors. Errors that are only detected from the numbers, like an invalid date,
+/// have to be checked with the `...Error()` functions before a token is converted.
+///
+class ScalarConverter final {
+public:
+    /// Check the numbers of a time.
+    ///
+    /// @param fields The numbers of a local time.
+    /// @return An empty string if the time is valid, or the error message.
+    ///
+    [[nodiscard]] static auto timeError(const DateTimeFields &fields) noexcept -> QString;
+
+    /// Check the numbers of a date/time.
+    ///
+    /// @param fields The numbers of a local or offset date/time.
+    /// @return An empty string if the date/time is valid, or the error message.
+    ///
+    [[nodiscard]] static auto dateTimeError(const DateTimeFields &fields) noexcept -> QString;
+
+    /// Convert the text of a decimal, hexadecimal, octal or binary integer.
+    ///
+    /// @param text The text of the integer.
+    /// @param ok Set to `false` if the integer does not fit into a signed 64-bit integer, otherwise `true`.
+    /// @return The integer, or zero if it does not fit.
+    ///
+    [[nodiscard]] static auto toInteger(QStringView text, bool *ok) noexcept -> int64_t;
+
+    /// Convert the text of a floating point value.
+    ///
+    /// Values are converted exactly from the digits, if the significant digits form an integer of at most
+    /// 2^53 (15 to 16 digits) and the decimal exponent is between -22 and 22. All other values are
+    /// converted by Qt.
+    ///
+    [[nodiscard]] static auto toFloat(QStringView text) noexcept -> double;
+
+    /// Create a timestamp from the numbers of a date or time.
+    ///
+    /// @param type The type of the value, either `Time`, `Date` or `DateTime`. Date/times with an offset are
+    ///     converted into offset date/times, all other date/times into local date/times.
+    /// @param fields The numbers of the token.
+    ///
+    [[nodiscard]] static auto toTimestamp(ValueType type, const DateTimeFields &fields) noexcept -> Timestamp;
+
+    /// Convert the text of a date or time.
+    ///
+    /// @param type The type of the value, either `Time`, `Date` or `DateTime`.
+    /// @param text The text of the token.
+    ///
+    [[nodiscard]] static auto toTimestamp(ValueType type, QStringView text) noexcept -> Timestamp;
+
+private:
+    /// Read the numbers of a date text.
+    ///
+    /// @param text The text of the date, with the format `YYYY-MM-DD`.
+    /// @param fields The fields that receive the numbers.
+    ///
+    static void readDateFields(QStringView text, DateTimeFields &fields) noexcept;
+
+    /// Read the numbers of a time text.
+    ///
+    /// @param text The text of the time, with the format `HH:MM[:SS[.fraction]][Z|(+|-)HH:MM]`.
+    /// @param fields The fields that receive the numbers.
+    ///
+    static void readTimeFields(QStringView text, DateTimeFields &fields) noexcept;
+
+    /// Convert the text of a floating point value without rounding errors, if possible.
+    ///
+    /// This is only possible if the mantissa is at most 2^53 and the decimal exponent is between -22 and 22,
+    /// so both are exactly representable as double.
+    ///
+    /// @param text The text of the value, without the sign.
+    /// @param result The converted value, if the conversion was possible.
+    /// @return `true` if the value was converted, `false` if it needs a full conversion.
+    ///
+    [[nodiscard]] static auto toFloatExactly(QStringView text, double &result) noexcept -> bool;
+
+    /// Get the value of a number of decimal digits.
+    ///
+    /// @param text The text with the digits.
+    /// @param index The index of the first digit.
+    /// @param count The number of digits.
+    ///
+    [[nodiscard]] static auto digitsValue(QStringView text, qsizetype index, qsizetype count) noexcept -> int;
+};
+
+
+}
+
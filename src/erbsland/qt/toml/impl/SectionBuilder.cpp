@@ -0,0 +1,107 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "SectionBuilder.hpp"
+
+
+#include <utility>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+SectionBuilder::SectionBuilder() noexcept
+    : _currentSection{KeyPath{}, false, Value::createTable(Value::Source::ExplicitTable)} {
+}
+
+
+auto SectionBuilder::takeCompletedSection(ReaderSection &section) noexcept -> bool {
+    if (!_hasCompletedSection) {
+        return false;
+    }
+    section = std::move(_completedSection);
+    _completedSection = {};
+    _hasCompletedSection = false;
+    return true;
+}
+
+
+auto SectionBuilder::takeCurrentSection() noexcept -> ReaderSection {
+    return std::exchange(_currentSection, {});
+}
+
+
+void SectionBuilder::onTable(const KeyPath &path) {
+    startSection(path, false);
+}
+
+
+void SectionBuilder::onArrayOfTables(const KeyPath &path) {
+    startSection(path, true);
+}
+
+
+void SectionBuilder::onKeyValue(const KeyPath &path, const ValuePtr &value) {
+    addValue(path, value);
+}
+
+
+void SectionBuilder::onArrayBegin(const KeyPath &path) {
+    auto array = Value::createArray(Value::Source::Value);
+    addValue(path, array);
+    _containers.push_back(Container{array, path.size()});
+}
+
+
+void SectionBuilder::onArrayEnd(const KeyPath&) {
+    _containers.pop_back();
+}
+
+
+void SectionBuilder::onInlineTableBegin(const KeyPath &path) {
+    auto table = Value::createTable(Value::Source::Value);
+    addValue(path, table);
+    _containers.push_back(Container{table, path.size()});
+}
+
+
+void SectionBuilder::onInlineTableEnd(const KeyPath&) {
+    _containers.pop_back();
+}
+
+
+void SectionBuilder::startSection(const KeyPath &path, bool isArrayOfTables) noexcept {
+    _completedSection = std::exchange(
+        _currentSection, ReaderSection{path, isArrayOfTables, Value::createTable(Value::Source::ExplicitTable)});
+    _hasCompletedSection = true;
+}
+
+
+void SectionBuilder::addValue(const KeyPath &path, const ValuePtr &value) noexcept {
+    auto table = _currentSection.table;
+    auto keyIndex = _currentSection.path.size();
+    if (!_containers.empty()) {
+        const auto &container = _containers.back();
+        if (container.value->isArray()) {
+            container.value->addValue(value);
+            return;
+        }
+        table = container.value;
+        keyIndex = container.pathSize;
+    }
+    // Create the tables of dotted keys, that are validated by the parser.
+    const auto &keys = path.keys();
+    for (; keyIndex < path.size() - 1; ++keyIndex) {
+        auto nextTable = table->valueFromKey(keys[keyIndex]);
+        if (nextTable == nullptr) {
+            nextTable = Value::createTable(Value::Source::ImplicitValue);
+            table->setValue(keys[keyIndex], nextTable);
+        }
+        table = nextTable;
+    }
+    table->setValue(keys.back(), value);
+}
+
+
+}
+
@@ -0,0 +1,85 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "../KeyPath.hpp"
+#include "../ParserHandler.hpp"
+#include "../Value.hpp"
+
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// A section of a document, that is read by `TomlReader`.
+///
+struct ReaderSection {
+    KeyPath path{}; ///< The path of the header, or an empty path for the root section.
+    bool isArrayOfTables{false}; ///< If the header is for an array of tables.
+    ValuePtr table{}; ///< The table with the assignments of the section.
+};
+
+
+/// @private
+/// A handler that builds the table of the current section from the parser events.
+///
+/// A table or array of tables header completes the current section and starts a new one.
+///
+class SectionBuilder final : public ParserHandler {
+public:
+    /// Create a new builder, starting with the root section.
+    ///
+    SectionBuilder() noexcept;
+
+public:
+    /// Take the completed section, if there is one.
+    ///
+    /// @param section The variable that receives the completed section.
+    /// @return `true` if a section was completed since the last call.
+    ///
+    [[nodiscard]] auto takeCompletedSection(ReaderSection &section) noexcept -> bool;
+
+    /// Take the current section at the end of the document.
+    ///
+    [[nodiscard]] auto takeCurrentSection() noexcept -> ReaderSection;
+
+public: // implement ParserHandler
+    void onTable(const KeyPath &path) override;
+    void onArrayOfTables(const KeyPath &path) override;
+    void onKeyValue(const KeyPath &path, const ValuePtr &value) override;
+    void onArrayBegin(const KeyPath &path) override;
+    void onArrayEnd(const KeyPath &path) override;
+    void onInlineTableBegin(const KeyPath &path) override;
+    void onInlineTableEnd(const KeyPath &path) override;
+
+private:
+    /// Complete the current section and start a new one.
+    ///
+    void startSection(const KeyPath &path, bool isArrayOfTables) noexcept;
+
+    /// Add a value to the current container.
+    ///
+    void addValue(const KeyPath &path, const ValuePtr &value) noexcept;
+
+private:
+    /// An array or inline table that is currently built.
+    ///
+    struct Container {
+        ValuePtr value; ///< The array or inline table.
+        qsizetype pathSize; ///< The size of the path of the container.
+    };
+
+private:
+    ReaderSection _currentSection; ///< The section that is built.
+    ReaderSection _completedSection; ///< The last completed section.
+    bool _hasCompletedSection{false}; ///< If there is a completed section.
+    std::vector<Container> _containers; ///< The stack of the arrays and inline tables that are built.
+};
+
+
+}
+
@@ -0,0 +1,179 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "SectionScanner.hpp"
+
+
+#include <cstring>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+SectionScanner::SectionScanner(const QByteArray &data) noexcept
+    : _data{reinterpret_cast<const uint8_t*>(data.constData())}, _size{data.size()} {
+}
+
+
+auto SectionScanner::splitIntoChunks(const QByteArray &data, qsizetype chunkSize) noexcept
+    -> std::vector<DocumentChunk> {
+
+    SectionScanner scanner{data};
+    std::vector<qsizetype> splitPositions;
+    qsizetype chunkBegin = 0;
+    while (scanner._position < scanner._size) {
+        const auto lineBegin = scanner._position;
+        while (scanner.byteAt(scanner._position) == ' ' || scanner.byteAt(scanner._position) == '\t') {
+            scanner._position += 1;
+        }
+        if (scanner.byteAt(scanner._position) == '[') {
+            if (lineBegin - chunkBegin >= chunkSize) {
+                splitPositions.push_back(lineBegin);
+                chunkBegin = lineBegin;
+            }
+            if (!scanner.skipHeaderLine()) {
+                return {};
+            }
+        } else if (!scanner.skipAssignmentLines()) {
+            return {};
+        }
+    }
+    if (splitPositions.empty()) {
+        return {};
+    }
+    std::vector<DocumentChunk> chunks;
+    chunks.reserve(splitPositions.size() + 1);
+    Location location;
+    qsizetype begin = 0;
+    splitPositions.push_back(scanner._size);
+    for (const auto end : splitPositions) {
+        chunks.push_back(DocumentChunk{begin, end, location});
+        location = locationAfter(data, begin, end, location);
+        begin = end;
+    }
+    return chunks;
+}
+
+
+auto SectionScanner::locationAfter(
+    const QByteArray &data,
+    qsizetype begin,
+    qsizetype end,
+    const Location &location) noexcept -> Location {
+
+    // Count the characters and lines in the range.
+    auto index = location.index();
+    auto line = location.line();
+    const auto *bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    for (auto position = begin; position < end; ++position) {
+        const auto byte = bytes[position];
+        if ((byte & 0b11000000U) != 0b10000000U) { // count all bytes except UTF-8 continuation bytes.
+            index += 1;
+        }
+        if (byte == '\n') {
+            line += 1;
+        }
+    }
+    return Location{index, line, 1};
+}
+
+
+auto SectionScanner::skipHeaderLine() noexcept -> bool {
+    while (_position < _size) {
+        const auto byte = _data[_position];
+        if (byte == '"' || byte == '\'') {
+            if (!skipString()) {
+                return false;
+            }
+        } else if (byte == '#') {
+            skipComment();
+        } else {
+            _position += 1;
+            if (byte == '\n') {
+                return true;
+            }
+        }
+    }
+    return true;
+}
+
+
+auto SectionScanner::skipAssignmentLines() noexcept -> bool {
+    int nestingLevel = 0;
+    while (_position < _size) {
+        const auto byte = _data[_position];
+        if (byte == '"' || byte == '\'') {
+            if (!skipString()) {
+                return false;
+            }
+            continue;
+        }
+        if (byte == '#') {
+            skipComment();
+            continue;
+        }
+        _position += 1;
+        if (byte == '[' || byte == '{') {
+            nestingLevel += 1;
+        } else if (byte == ']' || byte == '}') {
+            if (nestingLevel == 0) {
+                return false;
+            }
+            nestingLevel -= 1;
+        } else if (byte == '\n' && nestingLevel == 0) {
+            return true;
+        }
+    }
+    return nestingLevel == 0;
+}
+
+
+auto SectionScanner::skipString() noexcept -> bool {
+    const auto quote = _data[_position];
+    const bool hasEscapes = (quote == '"');
+    if (byteAt(_position + 1) == quote && byteAt(_position + 2) == quote) { // multi-line string.
+        _position += 3;
+        while (_position < _size) {
+            const auto byte = _data[_position];
+            if (hasEscapes && byte == '\\') {
+                _position += 2;
+            } else if (byte == quote && byteAt(_position + 1) == quote && byteAt(_position + 2) == quote) {
+                _position += 3;
+                // Up to two quotes directly before the closing delimiter are part of the string.
+                for (int i = 0; i < 2 && byteAt(_position) == quote; ++i) {
+                    _position += 1;
+                }
+                return true;
+            } else {
+                _position += 1;
+            }
+        }
+        return false;
+    }
+    _position += 1;
+    while (_position < _size) {
+        const auto byte = _data[_position];
+        if (byte == '\n') {
+            return false;
+        }
+        if (hasEscapes && byte == '\\') {
+            _position += 2;
+        } else {
+            _position += 1;
+            if (byte == quote) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+
+void SectionScanner::skipComment() noexcept {
+    const auto *end = std::memchr(_data + _position, '\n', static_cast<std::size_t>(_size - _position));
+    _position = (end != nullptr) ? static_cast<const uint8_t*>(end) - _data : _size;
+}
+
+
+}
+
@@ -0,0 +1,102 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "../Location.hpp"
+
+#include <QtCore/QByteArray>
+
+#include <cstdint>
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// A chunk of a document, that starts at the beginning of the document or with a table header.
+///
+struct DocumentChunk {
+    qsizetype begin{}; ///< The byte offset of the chunk.
+    qsizetype end{}; ///< The byte offset after the chunk.
+    Location location{}; ///< The location of the first character in the chunk.
+};
+
+
+/// @private
+/// A fast scanner that splits UTF-8 encoded documents at table headers and statements.
+///
+/// The scanner only looks at the structure of the document: Strings, comments and values that span
+/// multiple lines are skipped, and lines that start with a `[` outside of a value are table headers. It does
+/// not validate the document. If the document is invalid, the chunks may be split at the wrong positions,
+/// but parsing the chunks will fail in this case.
+///
+class SectionScanner final {
+public:
+    /// Split a document into chunks.
+    ///
+    /// @param data The UTF-8 encoded document.
+    /// @param chunkSize The minimum size of a chunk in bytes.
+    /// @return The chunks in document order, or an empty list if the document could not be split.
+    ///
+    [[nodiscard]] static auto splitIntoChunks(const QByteArray &data, qsizetype chunkSize) noexcept
+        -> std::vector<DocumentChunk>;
+
+    /// Get the location after a range of the data.
+    ///
+    /// @param data The UTF-8 encoded data.
+    /// @param begin The byte offset of the range, which must start a line.
+    /// @param end The byte offset after the range, which must start a line.
+    /// @param location The location at `begin`.
+    /// @return The location at `end`.
+    ///
+    [[nodiscard]] static auto locationAfter(
+        const QByteArray &data,
+        qsizetype begin,
+        qsizetype end,
+        const Location &location) noexcept -> Location;
+
+private:
+    /// Create a new scanner.
+    ///
+    explicit SectionScanner(const QByteArray &data) noexcept;
+
+    /// Get the byte at the given position, or zero at the end of the data.
+    ///
+    [[nodiscard]] inline auto byteAt(qsizetype position) const noexcept -> uint8_t {
+        return position < _size ? _data[position] : 0;
+    }
+
+    /// Skip a header line, starting at the `[`.
+    ///
+    /// @return `false` if the line is not complete.
+    ///
+    auto skipHeaderLine() noexcept -> bool;
+
+    /// Skip a line with an assignment, including all following lines that belong to the value.
+    ///
+    /// @return `false` if the structure of the lines is not valid.
+    ///
+    auto skipAssignmentLines() noexcept -> bool;
+
+    /// Skip a string, starting at the quote character.
+    ///
+    /// @return `false` if the string is not terminated.
+    ///
+    auto skipString() noexcept -> bool;
+
+    /// Skip the rest of the current line, after the `#` of a comment.
+    ///
+    void skipComment() noexcept;
+
+private:
+    const uint8_t *_data; ///< The scanned data.
+    qsizetype _size; ///< The size of the data.
+    qsizetype _position{}; ///< The current position.
+};
+
+
+}
+
@@ -0,0 +1,263 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "SnapshotData.hpp"
+
+
+#include "SnapshotFormat.hpp"
+
+#include "../Error.hpp"
+
+#include <QtCore/QMutexLocker>
+
+#include <algorithm>
+#include <utility>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+SnapshotData::SnapshotData(QByteArray data, std::unique_ptr<QFile> file) noexcept
+    : _data{std::move(data)}, _file{std::move(file)} {
+}
+
+
+auto SnapshotData::createOrThrow(
+    QByteArray data,
+    std::unique_ptr<QFile> file,
+    const QString &document,
+    uint64_t sourceChecksum) -> std::shared_ptr<SnapshotData> {
+
+    auto result = std::make_shared<SnapshotData>(std::move(data), std::move(file));
+    const auto &snapshot = *result;
+    if (snapshot._data.size() < SnapshotFormat::cHeaderSize
+        || std::memcmp(snapshot._data.constData(), SnapshotFormat::cMagic.data(), SnapshotFormat::cMagic.size()) != 0) {
+        throw Error{QStringLiteral("The file \"%1\" is no snapshot.").arg(document)};
+    }
+    if (snapshot.read<uint32_t>(SnapshotFormat::cByteOrderMarkOffset) != SnapshotFormat::cByteOrderMark) {
+        throw Error{QStringLiteral("The snapshot \"%1\" was written with a different byte order.").arg(document)};
+    }
+    if (snapshot.read<uint32_t>(SnapshotFormat::cVersionOffset) != SnapshotFormat::cVersion) {
+        throw Error{QStringLiteral("The snapshot \"%1\" has an unsupported version.").arg(document)};
+    }
+    if (snapshot.read<uint64_t>(SnapshotFormat::cSizeOffset) != static_cast<uint64_t>(snapshot._data.size())) {
+        throw Error{QStringLiteral("The snapshot \"%1\" is incomplete.").arg(document)};
+    }
+    if (snapshot.read<uint64_t>(SnapshotFormat::cSourceChecksumOffset) != sourceChecksum) {
+        throw Error{QStringLiteral("The snapshot \"%1\" was created from a different source document.").arg(document)};
+    }
+    result->_rootOffset = snapshot.read<uint64_t>(SnapshotFormat::cRootOffset);
+    if (const auto root = snapshot.createRootValue(); root == nullptr || !root->isTable()) {
+        throw Error{QStringLiteral("The snapshot \"%1\" has no valid root table.").arg(document)};
+    }
+    return result;
+}
+
+
+auto SnapshotData::createRootValue() const noexcept -> ValuePtr {
+    return createValue(_rootOffset, static_cast<uint64_t>(_data.size()));
+}
+
+
+auto SnapshotData::readTable(uint64_t offset) const noexcept -> Value::TableValue {
+    Value::TableValue result;
+    const auto count = containerCount(offset, ValueType::Table);
+    if (count <= 0) {
+        return result;
+    }
+    result.reserve(static_cast<std::size_t>(count));
+    QMutexLocker locker{&_keyMutex};
+    auto entryOffset = offset + SnapshotFormat::cNodeHeaderSize;
+    for (int64_t i = 0; i < count; ++i, entryOffset += 16) {
+        QString key;
+        if (!readKey(read<uint64_t>(entryOffset), offset, key)) {
+            continue;
+        }
+        if (auto value = createValue(read<uint64_t>(entryOffset + 8), offset); value != nullptr) {
+            result.insert_or_assign(key, std::move(value));
+        }
+    }
+    return result;
+}
+
+
+auto SnapshotData::readArray(uint64_t offset) const noexcept -> Value::ArrayValue {
+    Value::ArrayValue result;
+    const auto count = containerCount(offset, ValueType::Array);
+    if (count <= 0) {
+        return result;
+    }
+    result.reserve(static_cast<std::size_t>(count));
+    auto valueOffset = offset + SnapshotFormat::cNodeHeaderSize;
+    for (int64_t i = 0; i < count; ++i, valueOffset += 8) {
+        if (auto value = createValue(read<uint64_t>(valueOffset), offset); value != nullptr) {
+            result.emplace_back(std::move(value));
+        }
+    }
+    return result;
+}
+
+
+auto SnapshotData::mayContainKey(uint64_t offset, QStringView key) const noexcept -> bool {
+    const auto count = containerCount(offset, ValueType::Table);
+    if (count < 0) {
+        return true;
+    }
+    const auto entriesOffset = offset + SnapshotFormat::cNodeHeaderSize;
+    const auto indexOffset = entriesOffset + static_cast<uint64_t>(count) * 16;
+    int64_t first = 0;
+    int64_t last = count;
+    while (first < last) {
+        const auto middle = first + (last - first) / 2;
+        const auto entryIndex = read<uint32_t>(indexOffset + static_cast<uint64_t>(middle) * 4);
+        if (entryIndex >= count) {
+            return true;
+        }
+        const auto keyOffset = read<uint64_t>(entriesOffset + static_cast<uint64_t>(entryIndex) * 16);
+        if (keyOffset >= offset || !isValidRecord(keyOffset, 4, offset)
+            || !isValidRecord(keyOffset, 4 + static_cast<uint64_t>(read<uint32_t>(keyOffset)) * 2, offset)) {
+            return true;
+        }
+        const auto comparison = compareKey(keyOffset, key);
+        if (comparison == 0) {
+            return true;
+        }
+        if (comparison < 0) {
+            first = middle + 1;
+        } else {
+            last = middle;
+        }
+    }
+    return false;
+}
+
+
+auto SnapshotData::createValue(uint64_t offset, uint64_t parentOffset) const noexcept -> ValuePtr {
+    if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize, parentOffset)) {
+        return {};
+    }
+    const auto typeIndex = read<uint8_t>(offset);
+    const auto sourceIndex = read<uint8_t>(offset + 1);
+    const auto count = read<uint32_t>(offset + 4);
+    if (typeIndex > static_cast<uint8_t>(ValueType::Array) || sourceIndex > static_cast<uint8_t>(ValueSource::Value)) {
+        return {};
+    }
+    const auto type = static_cast<ValueType>(typeIndex);
+    const auto source = static_cast<ValueSource>(sourceIndex);
+    const auto payloadOffset = offset + SnapshotFormat::cNodeHeaderSize;
+    const auto createStoredValue = [type, source](Value::Storage storage) -> ValuePtr {
+        return std::make_shared<Value>(type, source, std::move(storage), Value::PrivateTag{});
+    };
+    switch (type) {
+    case ValueType::Integer:
+        if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize + 8, parentOffset)) {
+            return {};
+        }
+        return createStoredValue(read<int64_t>(payloadOffset));
+    case ValueType::Float:
+        if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize + 8, parentOffset)) {
+            return {};
+        }
+        return createStoredValue(read<double>(payloadOffset));
+    case ValueType::Boolean:
+        return createStoredValue(count != 0);
+    case ValueType::String: {
+        if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize + static_cast<uint64_t>(count) * 2, parentOffset)) {
+            return {};
+        }
+        QString text;
+        text.resize(static_cast<qsizetype>(count));
+        std::memcpy(text.data(), _data.constData() + payloadOffset, static_cast<std::size_t>(count) * 2);
+        return createStoredValue(std::move(text));
+    }
+    case ValueType::Time:
+    case ValueType::Date:
+    case ValueType::DateTime: {
+        if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize + SnapshotFormat::cTimestampSize, parentOffset)) {
+            return {};
+        }
+        const auto kindIndex = read<uint8_t>(payloadOffset + 20);
+        if (kindIndex > static_cast<uint8_t>(Timestamp::Kind::OffsetDateTime)) {
+            return {};
+        }
+        return createStoredValue(Timestamp{
+            static_cast<Timestamp::Kind>(kindIndex),
+            read<int64_t>(payloadOffset),
+            read<int64_t>(payloadOffset + 8),
+            read<int32_t>(payloadOffset + 16)});
+    }
+    case ValueType::Table:
+    case ValueType::Array:
+        if (containerCount(offset, type) < 0 || offset >= parentOffset) {
+            return {};
+        }
+        return createStoredValue(Value::SnapshotNode{shared_from_this(), offset});
+    }
+    return {};
+}
+
+
+auto SnapshotData::containerCount(uint64_t offset, ValueType type) const noexcept -> int64_t {
+    const auto limit = static_cast<uint64_t>(_data.size());
+    if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize, limit)
+        || read<uint8_t>(offset) != static_cast<uint8_t>(type)) {
+        return -1;
+    }
+    const auto count = static_cast<uint64_t>(read<uint32_t>(offset + 4));
+    const auto payloadSize = (type == ValueType::Table) ? count * 20 : count * 8;
+    if (!isValidRecord(offset, SnapshotFormat::cNodeHeaderSize + payloadSize, limit)) {
+        return -1;
+    }
+    return static_cast<int64_t>(count);
+}
+
+
+auto SnapshotData::readKey(uint64_t offset, uint64_t parentOffset, QString &key) const noexcept -> bool {
+    if (offset >= parentOffset) {
+        return false;
+    }
+    if (_keys.contains(offset)) {
+        key = _keys.value(offset);
+        return true;
+    }
+    if (!isValidRecord(offset, 4, parentOffset)) {
+        return false;
+    }
+    const auto length = read<uint32_t>(offset);
+    if (!isValidRecord(offset, 4 + static_cast<uint64_t>(length) * 2, parentOffset)) {
+        return false;
+    }
+    key.resize(static_cast<qsizetype>(length));
+    std::memcpy(key.data(), _data.constData() + offset + 4, static_cast<std::size_t>(length) * 2);
+    _keys.insert(offset, key);
+    return true;
+}
+
+
+auto SnapshotData::compareKey(uint64_t offset, QStringView text) const noexcept -> int {
+    const auto length = static_cast<qsizetype>(read<uint32_t>(offset));
+    const auto commonLength = std::min(length, text.size());
+    for (qsizetype i = 0; i < commonLength; ++i) {
+        const auto keyChar = read<char16_t>(offset + 4 + static_cast<uint64_t>(i) * 2);
+        const auto textChar = text[i].unicode();
+        if (keyChar != textChar) {
+            return (keyChar < textChar) ? -1 : 1;
+        }
+    }
+    if (length == text.size()) {
+        return 0;
+    }
+    return (length < text.size()) ? -1 : 1;
+}
+
+
+auto SnapshotData::isValidRecord(uint64_t offset, uint64_t size, uint64_t limit) const noexcept -> bool {
+    return offset >= static_cast<uint64_t>(SnapshotFormat::cHeaderSize)
+        && offset % SnapshotFormat::cAlignment == 0
+        && offset < limit
+        && size <= static_cast<uint64_t>(_data.size()) - offset;
+}
+
+
+}
+
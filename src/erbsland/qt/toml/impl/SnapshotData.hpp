@@ -0,0 +1,150 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "../Value.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QStringView>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// The data of a loaded snapshot.
+///
+/// Tables and arrays of a snapshot are loaded one level at a time, when they are accessed for the first
+/// time. Until then, each of them keeps a shared pointer to this data. All offsets are verified before
+/// they are used, and invalid nodes are skipped, so a damaged snapshot never reads outside the data.
+///
+/// @see SnapshotFormat
+///
+class SnapshotData final : public std::enable_shared_from_this<SnapshotData> {
+public:
+    /// Create the data for a snapshot.
+    ///
+    /// Use `createOrThrow()` to verify the header.
+    ///
+    /// @param data The snapshot data.
+    /// @param file The file of the mapped data, which has to stay open, or `nullptr`.
+    ///
+    SnapshotData(QByteArray data, std::unique_ptr<QFile> file) noexcept;
+
+    /// Create the data for a snapshot and verify its header.
+    ///
+    /// @param data The snapshot data.
+    /// @param file The file of the mapped data, which has to stay open, or `nullptr`.
+    /// @param document The name of the snapshot for errors.
+    /// @param sourceChecksum The expected checksum of the source document.
+    /// @return The snapshot data.
+    /// @throws Error if the snapshot is not valid, or was created from a different source document.
+    ///
+    [[nodiscard]] static auto createOrThrow(
+        QByteArray data,
+        std::unique_ptr<QFile> file,
+        const QString &document,
+        uint64_t sourceChecksum) -> std::shared_ptr<SnapshotData>;
+
+public:
+    /// Create the root table of the snapshot.
+    ///
+    [[nodiscard]] auto createRootValue() const noexcept -> ValuePtr;
+
+    /// Read the entries of a table node.
+    ///
+    [[nodiscard]] auto readTable(uint64_t offset) const noexcept -> Value::TableValue;
+
+    /// Read the values of an array node.
+    ///
+    [[nodiscard]] auto readArray(uint64_t offset) const noexcept -> Value::ArrayValue;
+
+    /// Test if a table node may contain a key, using the sorted key index.
+    ///
+    /// @return `false` if the table does not contain the key, `true` if it contains it or if the node
+    ///     is not valid.
+    ///
+    [[nodiscard]] auto mayContainKey(uint64_t offset, QStringView key) const noexcept -> bool;
+
+    /// Access the mutex to load the nodes.
+    ///
+    /// A value locks this mutex while it loads its node, so each node is loaded only once, even if
+    /// multiple threads access the value at the same time.
+    ///
+    [[nodiscard]] inline auto loadMutex() const noexcept -> QMutex& {
+        return _loadMutex;
+    }
+
+private:
+    /// Create a value for a node.
+    ///
+    /// @param offset The offset of the node.
+    /// @param parentOffset The offset of the parent node. Valid nodes are always written before their parent.
+    /// @return The value, or `nullptr` if the node is not valid.
+    ///
+    [[nodiscard]] auto createValue(uint64_t offset, uint64_t parentOffset) const noexcept -> ValuePtr;
+
+    /// Test if a node of a table or array is valid.
+    ///
+    /// @param offset The offset of the node.
+    /// @param type The expected type.
+    /// @return The number of entries or values, or -1 if the node is not valid.
+    ///
+    [[nodiscard]] auto containerCount(uint64_t offset, ValueType type) const noexcept -> int64_t;
+
+    /// Read a key.
+    ///
+    /// @param offset The offset of the key.
+    /// @param parentOffset The offset of the table with the key.
+    /// @param key The key that was read.
+    /// @return `true` if the key is valid.
+    ///
+    [[nodiscard]] auto readKey(uint64_t offset, uint64_t parentOffset, QString &key) const noexcept -> bool;
+
+    /// Compare a key with a text, by their UTF-16 code units.
+    ///
+    /// @param offset The offset of a valid key.
+    /// @param text The text to compare.
+    /// @return A negative number, zero or a positive number, if the key is less, equal or greater.
+    ///
+    [[nodiscard]] auto compareKey(uint64_t offset, QStringView text) const noexcept -> int;
+
+    /// Test if a record is within the data.
+    ///
+    /// @param offset The offset of the record.
+    /// @param size The size of the record.
+    /// @param limit The offset where the record has to end before.
+    ///
+    [[nodiscard]] auto isValidRecord(uint64_t offset, uint64_t size, uint64_t limit) const noexcept -> bool;
+
+    /// Read a number from the data.
+    ///
+    template<typename T>
+    [[nodiscard]] auto read(uint64_t offset) const noexcept -> T {
+        T value;
+        std::memcpy(&value, _data.constData() + offset, sizeof(T));
+        return value;
+    }
+
+private:
+    QByteArray _data; ///< The snapshot data.
+    std::unique_ptr<QFile> _file; ///< The mapped file, or `nullptr`.
+    uint64_t _rootOffset{}; ///< The offset of the root node.
+    mutable QMutex _loadMutex; ///< The mutex to load the nodes.
+    mutable QMutex _keyMutex; ///< The mutex for the key cache.
+    mutable QHash<uint64_t, QString> _keys; ///< The keys that were read, to share them between the tables.
+};
+
+
+}
+
@@ -0,0 +1,58 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <QtCore/QtGlobal>
+
+#include <array>
+#include <cstdint>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// The layout of the binary snapshot format.
+///
+/// All numbers are stored in the byte order of the writing system, which is detected with the byte order
+/// mark in the header. Every record starts at an offset that is a multiple of eight. Each node is written
+/// after all the nodes and keys it points to, so every offset in a node is smaller than the node offset.
+///
+/// - Header: magic (8), version (u32), byte order mark (u32), source checksum (u64), size (u64),
+///   root offset (u64).
+/// - Node: type (u8), source (u8), zero (u16), count (u32), followed by the payload for the type:
+///   - Integer, Float: the value (8 bytes).
+///   - Boolean: no payload, the count is the value.
+///   - String: the count is the number of UTF-16 code units, followed by the code units.
+///   - Time, Date, DateTime: Julian day (i64), nanoseconds of day (i64), offset seconds (i32), kind (u8).
+///   - Array: the count is the number of values, followed by the value offsets (u64 each).
+///   - Table: the count is the number of entries, followed by the key and value offset (u64 each) of each
+///     entry in definition order, and the indexes of the entries in the order of their keys (u32 each).
+/// - Key: length (u32), followed by the UTF-16 code units. Keys are shared by all tables.
+///
+struct SnapshotFormat {
+    static constexpr std::array<char, 8> cMagic = {'E', 'T', 'O', 'M', 'L', 'S', 'N', 'P'}; ///< The magic bytes.
+    static constexpr uint32_t cVersion = 1; ///< The version of the format.
+    static constexpr uint32_t cByteOrderMark = 0x01020304U; ///< The byte order mark.
+    static constexpr qsizetype cHeaderSize = 40; ///< The size of the header.
+    static constexpr qsizetype cVersionOffset = 8; ///< The offset of the version in the header.
+    static constexpr qsizetype cByteOrderMarkOffset = 12; ///< The offset of the byte order mark in the header.
+    static constexpr qsizetype cSourceChecksumOffset = 16; ///< The offset of the source checksum in the header.
+    static constexpr qsizetype cSizeOffset = 24; ///< The offset of the size in the header.
+    static constexpr qsizetype cRootOffset = 32; ///< The offset of the root node offset in the header.
+    static constexpr qsizetype cNodeHeaderSize = 8; ///< The size of the header of a node.
+    static constexpr qsizetype cTimestampSize = 24; ///< The size of the payload of a timestamp.
+    static constexpr qsizetype cAlignment = 8; ///< The alignment of all records.
+
+    /// Get the size, rounded up to the alignment.
+    ///
+    [[nodiscard]] static constexpr auto aligned(qsizetype size) noexcept -> qsizetype {
+        return (size + cAlignment - 1) & ~(cAlignment - 1);
+    }
+};
+
+
+}
+
@@ -0,0 +1,157 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "SnapshotWriter.hpp"
+
+
+#include "SnapshotFormat.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+SnapshotWriter::SnapshotWriter(uint64_t sourceChecksum) noexcept
+    : _sourceChecksum{sourceChecksum} {
+}
+
+
+auto SnapshotWriter::write(const Value &root) -> QByteArray {
+    _data.clear();
+    _keyOffsets.clear();
+    _data.append(SnapshotFormat::cMagic.data(), static_cast<qsizetype>(SnapshotFormat::cMagic.size()));
+    append(SnapshotFormat::cVersion);
+    append(SnapshotFormat::cByteOrderMark);
+    append(_sourceChecksum);
+    append(uint64_t{0}); // the size, written at the end.
+    append(uint64_t{0}); // the root offset, written at the end.
+    const auto rootOffset = writeValue(root);
+    const auto size = static_cast<uint64_t>(_data.size());
+    std::memcpy(_data.data() + SnapshotFormat::cSizeOffset, &size, sizeof(size));
+    std::memcpy(_data.data() + SnapshotFormat::cRootOffset, &rootOffset, sizeof(rootOffset));
+    auto result = std::move(_data);
+    _data = QByteArray{};
+    _keyOffsets.clear();
+    return result;
+}
+
+
+auto SnapshotWriter::writeValue(const Value &value) -> uint64_t {
+    uint64_t offset;
+    switch (value.type()) {
+    case ValueType::Integer:
+        offset = writeNodeHeader(value, 0);
+        append(value.toInteger());
+        break;
+    case ValueType::Float:
+        offset = writeNodeHeader(value, 0);
+        append(value.toFloat());
+        break;
+    case ValueType::Boolean:
+        offset = writeNodeHeader(value, value.toBoolean() ? 1U : 0U);
+        break;
+    case ValueType::String: {
+        const auto text = value.toStringView();
+        offset = writeNodeHeader(value, static_cast<uint32_t>(text.size()));
+        appendText(text);
+        break;
+    }
+    case ValueType::Time:
+    case ValueType::Date:
+    case ValueType::DateTime: {
+        const auto timestamp = value.toTimestamp();
+        offset = writeNodeHeader(value, 0);
+        append(timestamp.julianDay());
+        append(timestamp.nanosecondsOfDay());
+        append(timestamp.offsetSeconds());
+        append(static_cast<uint8_t>(timestamp.kind()));
+        break;
+    }
+    case ValueType::Array: {
+        // The children are written first, so the node can refer to them.
+        const auto &array = value.arrayStorage();
+        std::vector<uint64_t> valueOffsets;
+        valueOffsets.reserve(array.size());
+        for (const auto &child : array) {
+            valueOffsets.push_back(writeValue(*child));
+        }
+        offset = writeNodeHeader(value, static_cast<uint32_t>(valueOffsets.size()));
+        for (const auto valueOffset : valueOffsets) {
+            append(valueOffset);
+        }
+        break;
+    }
+    case ValueType::Table: {
+        const auto &table = value.tableStorage();
+        std::vector<std::pair<uint64_t, uint64_t>> entryOffsets;
+        entryOffsets.reserve(table.size());
+        for (const auto &[key, child] : table) {
+            const auto keyOffset = writeKey(key);
+            entryOffsets.emplace_back(keyOffset, writeValue(*child));
+        }
+        std::vector<uint32_t> sortedIndexes(table.size());
+        std::iota(sortedIndexes.begin(), sortedIndexes.end(), 0U);
+        std::sort(sortedIndexes.begin(), sortedIndexes.end(), [&table](uint32_t a, uint32_t b) {
+            const auto &keyA = (table.begin() + a)->first;
+            const auto &keyB = (table.begin() + b)->first;
+            return std::lexicographical_compare(keyA.begin(), keyA.end(), keyB.begin(), keyB.end());
+        });
+        offset = writeNodeHeader(value, static_cast<uint32_t>(entryOffsets.size()));
+        for (const auto &[keyOffset, valueOffset] : entryOffsets) {
+            append(keyOffset);
+            append(valueOffset);
+        }
+        for (const auto index : sortedIndexes) {
+            append(index);
+        }
+        break;
+    }
+    }
+    appendPadding();
+    return offset;
+}
+
+
+auto SnapshotWriter::writeKey(const QString &key) -> uint64_t {
+    // Offset zero is the header, so it is never the offset of a key.
+    if (const auto existingOffset = _keyOffsets.value(key, 0); existingOffset != 0) {
+        return existingOffset;
+    }
+    const auto offset = static_cast<uint64_t>(_data.size());
+    append(static_cast<uint32_t>(key.size()));
+    appendText(key);
+    appendPadding();
+    _keyOffsets.insert(key, offset);
+    return offset;
+}
+
+
+auto SnapshotWriter::writeNodeHeader(const Value &value, uint32_t count) -> uint64_t {
+    const auto offset = static_cast<uint64_t>(_data.size());
+    append(static_cast<uint8_t>(value.type()));
+    append(static_cast<uint8_t>(value.source()));
+    append(uint16_t{0});
+    append(count);
+    return offset;
+}
+
+
+void SnapshotWriter::appendText(QStringView text) {
+    _data.append(reinterpret_cast<const char*>(text.data()), text.size() * static_cast<qsizetype>(sizeof(QChar)));
+}
+
+
+void SnapshotWriter::appendPadding() {
+    const auto size = _data.size();
+    for (auto i = size; i < SnapshotFormat::aligned(size); ++i) {
+        _data.append('\0');
+    }
+}
+
+
+}
@@ -0,0 +1,85 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "../Value.hpp"
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringView>
+
+#include <cstdint>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// Writes a value tree into the binary snapshot format.
+///
+/// @see SnapshotFormat
+///
+class SnapshotWriter final {
+public:
+    /// Create a new writer.
+    ///
+    /// @param sourceChecksum The checksum of the source document, stored in the header.
+    ///
+    explicit SnapshotWriter(uint64_t sourceChecksum) noexcept;
+
+public:
+    /// Write a value tree.
+    ///
+    /// @param root The root value.
+    /// @return The snapshot data.
+    ///
+    [[nodiscard]] auto write(const Value &root) -> QByteArray;
+
+private:
+    /// Write a value and all its children.
+    ///
+    /// @return The offset of the node for the value.
+    ///
+    auto writeValue(const Value &value) -> uint64_t;
+
+    /// Write a key, or get the offset of a key that was already written.
+    ///
+    /// @return The offset of the key.
+    ///
+    auto writeKey(const QString &key) -> uint64_t;
+
+    /// Write the header of a new node.
+    ///
+    /// @param value The value for the node.
+    /// @param count The count field of the node.
+    /// @return The offset of the node.
+    ///
+    auto writeNodeHeader(const Value &value, uint32_t count) -> uint64_t;
+
+    /// Append a number in the byte order of this system.
+    ///
+    template<typename T>
+    void append(T value) {
+        _data.append(reinterpret_cast<const char*>(&value), static_cast<qsizetype>(sizeof(T)));
+    }
+
+    /// Append UTF-16 code units.
+    ///
+    void appendText(QStringView text);
+
+    /// Append zero bytes up to the next aligned offset.
+    ///
+    void appendPadding();
+
+private:
+    uint64_t _sourceChecksum; ///< The checksum of the source document.
+    QByteArray _data; ///< The snapshot data.
+    QHash<QString, uint64_t> _keyOffsets; ///< The offsets of the keys that were written.
+};
+
+
+}
+
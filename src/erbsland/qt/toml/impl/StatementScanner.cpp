@@ -0,0 +1,144 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "StatementScanner.hpp"
+
+
+#include <cstring>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+auto StatementScanner::scan(const QByteArray &data) noexcept -> qsizetype {
+    const auto *bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    const auto size = data.size();
+    qsizetype length = 0;
+    while (_position < size && _state != State::Invalid) {
+        const auto byte = bytes[_position];
+        switch (_state) {
+        case State::LineStart:
+            if (byte == ' ' || byte == '\t') {
+                _position += 1;
+            } else if (byte == '[') {
+                _position += 1;
+                _state = State::Header;
+            } else {
+                _state = State::Assignment; // scan this byte again as part of the assignment.
+            }
+            break;
+        case State::Header:
+        case State::Assignment:
+            if (byte == '"' || byte == '\'') {
+                _context = _state;
+                _quote = byte;
+                _quoteCount = 1;
+                _state = State::StringStart;
+            } else if (byte == '#') {
+                _context = _state;
+                _state = State::Comment;
+            } else if (byte == '\n') {
+                if (_state == State::Header || _nestingLevel == 0) {
+                    length = _position + 1;
+                    _state = State::LineStart;
+                }
+            } else if (_state == State::Assignment) {
+                if (byte == '[' || byte == '{') {
+                    _nestingLevel += 1;
+                } else if (byte == ']' || byte == '}') {
+                    if (_nestingLevel == 0) {
+                        _state = State::Invalid;
+                        break;
+                    }
+                    _nestingLevel -= 1;
+                }
+            }
+            _position += 1;
+            break;
+        case State::Comment: {
+            // The newline ends the comment and is scanned again in the context of the comment.
+            const auto *end = std::memchr(bytes + _position, '\n', static_cast<std::size_t>(size - _position));
+            if (end != nullptr) {
+                _position = static_cast<const uint8_t*>(end) - bytes;
+                _state = _context;
+            } else {
+                _position = size;
+            }
+            break;
+        }
+        case State::StringStart:
+            if (byte == _quote && _quoteCount < 3) {
+                _position += 1;
+                _quoteCount += 1;
+                if (_quoteCount == 3) {
+                    _state = State::MultiLineString;
+                }
+            } else if (_quoteCount == 2) {
+                _state = _context; // an empty string, scan this byte again in the context of the string.
+            } else {
+                _state = State::String;
+            }
+            break;
+        case State::String:
+            if (byte == '\n') {
+                _state = State::Invalid;
+                break;
+            }
+            _position += 1;
+            if (byte == '\\' && _quote == '"') {
+                _state = State::StringEscape;
+            } else if (byte == _quote) {
+                _state = _context;
+            }
+            break;
+        case State::StringEscape:
+            _position += 1;
+            _state = State::String;
+            break;
+        case State::MultiLineString:
+            _position += 1;
+            if (byte == '\\' && _quote == '"') {
+                _state = State::MultiLineEscape;
+            } else if (byte == _quote) {
+                _quoteCount = 1;
+                _state = State::MultiLineEnd;
+            }
+            break;
+        case State::MultiLineEscape:
+            _position += 1;
+            _state = State::MultiLineString;
+            break;
+        case State::MultiLineEnd:
+            // Up to two quotes directly before the closing delimiter are part of the string.
+            if (byte == _quote && _quoteCount < 5) {
+                _position += 1;
+                _quoteCount += 1;
+            } else if (_quoteCount >= 3) {
+                _state = _context; // scan this byte again in the context of the string.
+            } else {
+                _state = State::MultiLineString; // scan this byte again as part of the string.
+            }
+            break;
+        case State::Invalid:
+            break;
+        }
+    }
+    if (_state == State::Invalid) {
+        // Return the data up to and including the invalid byte, so parsing it reports the error right away,
+        // instead of collecting more and more data that can never form a complete statement.
+        length = _position + 1;
+        reset();
+        return length;
+    }
+    _position -= length;
+    return length;
+}
+
+
+void StatementScanner::reset() noexcept {
+    *this = StatementScanner{};
+}
+
+
+}
+
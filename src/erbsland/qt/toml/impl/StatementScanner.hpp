@@ -0,0 +1,71 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <QtCore/QByteArray>
+
+#include <cstdint>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// A scanner that finds the complete statements in a document that is received in parts.
+///
+/// The scanner uses the same rules as `SectionScanner`, but it keeps its state between the calls. Each
+/// call only scans the bytes that were added since the last call, so a long statement that arrives in many
+/// small parts is never scanned again.
+///
+class StatementScanner final {
+public:
+    /// Scan the data that was added since the last call.
+    ///
+    /// The first bytes, up to the returned length, are complete statements. They must be removed from the
+    /// start of the data before the next call.
+    ///
+    /// If the structure of the data is invalid, e.g. because of a closing bracket without an opening one,
+    /// the returned length ends with the invalid byte, and the scanner starts over after it. Parsing this
+    /// part reports the syntax error.
+    ///
+    /// @param data The UTF-8 encoded pending data, that starts with a statement.
+    /// @return The number of bytes of the complete statements at the start of the data, or of the data up to
+    ///     the invalid byte.
+    ///
+    [[nodiscard]] auto scan(const QByteArray &data) noexcept -> qsizetype;
+
+    /// Reset the scanner for a new document.
+    ///
+    void reset() noexcept;
+
+private:
+    /// The state of the scanner.
+    ///
+    enum class State : uint8_t {
+        LineStart, ///< Skipping the indentation at the start of a statement.
+        Header, ///< In a table header.
+        Assignment, ///< In an assignment or the value of it.
+        Comment, ///< In a comment.
+        StringStart, ///< After the opening quotes of a string.
+        String, ///< In a single-line string.
+        StringEscape, ///< After a backslash in a single-line string.
+        MultiLineString, ///< In a multi-line string.
+        MultiLineEscape, ///< After a backslash in a multi-line string.
+        MultiLineEnd, ///< At the closing quotes of a multi-line string.
+        Invalid, ///< The structure of the data is invalid at the current position.
+    };
+
+private:
+    qsizetype _position{}; ///< The position of the next byte to scan.
+    State _state{State::LineStart}; ///< The current state.
+    State _context{State::Assignment}; ///< The state after a string or comment, `Header` or `Assignment`.
+    uint8_t _quote{}; ///< The quote character of the current string.
+    int _quoteCount{}; ///< The number of consecutive quotes in `StringStart` and `MultiLineEnd`.
+    int _nestingLevel{}; ///< The nesting level of arrays and inline tables in the current assignment.
+};
+
+
+}
+
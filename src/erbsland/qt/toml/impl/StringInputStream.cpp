@@ -31,7 +31,12 @@ auto StringInputStream::readOrThrow() -> Char {
     if (atEnd()) {
         return {};
     }
-    auto character1 = _textCopy.at(_readPosition++);
+    return decodeOrThrow(_readPosition);
+}
+
+
+auto StringInputStream::decodeOrThrow(qsizetype &position) const -> Char {
+    auto character1 = _textCopy.at(position++);
     Char readChar;
     if (!character1.isHighSurrogate()) {
         readChar = Char{static_cast<uint32_t>(character1.unicode())};
@@ -43,10 +48,10 @@ auto StringInputStream::readOrThrow() -> Char {
     if (character1.isLowSurrogate()) {
         throw Error::createEncoding(document(), {});
     }
-    if (atEnd()) {
+    if (position >= _textCopy.size()) {
         throw Error::createEncoding(document(), {});
     }
-    auto character2 = _textCopy.at(_readPosition++);
+    auto character2 = _textCopy.at(position++);
     if (character2.isHighSurrogate()) {
         throw Error::createEncoding(document(), {});
     }
@@ -58,6 +63,30 @@ auto StringInputStream::readOrThrow() -> Char {
 }
 
 
+auto StringInputStream::readBlockOrThrow(Char *buffer, qsizetype maximumSize) -> qsizetype {
+    const auto *text = _textCopy.constData();
+    const auto size = _textCopy.size();
+    qsizetype count = 0;
+    while (count < maximumSize && _readPosition < size) {
+        const auto character1 = text[_readPosition];
+        if (!character1.isSurrogate()) {
+            buffer[count] = Char{static_cast<char32_t>(character1.unicode())};
+            _readPosition += 1;
+        } else if (character1.isHighSurrogate() && _readPosition + 1 < size
+            && text[_readPosition + 1].isLowSurrogate()) {
+            buffer[count] = Char{static_cast<char32_t>(QChar::surrogateToUcs4(character1, text[_readPosition + 1]))};
+            _readPosition += 2;
+        } else if (count == 0) {
+            buffer[count] = readOrThrow(); // throws the encoding error.
+        } else {
+            break; // report the error with the next call.
+        }
+        count += 1;
+    }
+    return count;
+}
+
+
 }
 
 
@@ -27,11 +27,28 @@ public:
 public: // implement InputStream
     [[nodiscard]] auto atEnd() noexcept -> bool override;
     [[nodiscard]] auto readOrThrow() -> Char override;
+    auto readBlockOrThrow(Char *buffer, qsizetype maximumSize) -> qsizetype override;
     [[nodiscard]] auto document() const noexcept -> QString override;
 
+public:
+    /// Access the text of this stream.
+    ///
+    [[nodiscard]] inline auto text() const noexcept -> const QString& {
+        return _textCopy;
+    }
+
+    /// Decode the character at the given position in the text.
+    ///
+    /// @param position The position of the character in the text, which has to be valid. It is moved
+    ///     behind the decoded character.
+    /// @return The decoded character.
+    /// @throws Error if there is an encoding error at the given position.
+    ///
+    [[nodiscard]] auto decodeOrThrow(qsizetype &position) const -> Char;
+
 private:
-    int _readPosition{}; ///< The read position in the string.
-    QString _textCopy{}; ///< A copy of the text for the stream.
+    qsizetype _readPosition{}; ///< The read position in the string.
+    QString _textCopy{}; ///< A shallow, implicitly shared copy of the text for the stream.
 };
 
 
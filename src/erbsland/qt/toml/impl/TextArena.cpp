@@ -0,0 +1,55 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "TextArena.hpp"
+
+
+#include <algorithm>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+auto TextArena::store(QStringView text) -> QStringView {
+    const auto size = text.size();
+    if (size == 0) {
+        return {};
+    }
+    if (_chunks.empty() || _chunkCapacity - _chunkUsed < size) {
+        const auto capacity = std::max(size, cChunkSize);
+        _chunks.emplace_back(new QChar[static_cast<std::size_t>(capacity)]);
+        _chunkCapacity = capacity;
+        _chunkUsed = 0;
+    }
+    auto *destination = _chunks.back().get() + _chunkUsed;
+    std::copy(text.begin(), text.end(), destination);
+    _chunkUsed += size;
+    return {destination, size};
+}
+
+
+void TextArena::clear() noexcept {
+    if (_chunks.empty()) {
+        return;
+    }
+    if (_chunks.size() > 1) {
+        std::swap(_chunks.front(), _chunks.back()); // keep the last chunk, which has its capacity set.
+        _chunks.resize(1);
+    }
+    if (_chunkCapacity > cChunkSize) { // do not keep the large chunk of a single long text.
+        release();
+        return;
+    }
+    _chunkUsed = 0;
+}
+
+
+void TextArena::release() noexcept {
+    _chunks.clear();
+    _chunkCapacity = 0;
+    _chunkUsed = 0;
+}
+
+
+}
+
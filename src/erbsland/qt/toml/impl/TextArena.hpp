@@ -0,0 +1,55 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <QtCore/QChar>
+#include <QtCore/QStringView>
+
+#include <memory>
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// A storage for token texts that are not part of the source text.
+///
+/// The texts are copied into large chunks that are never moved, therefore a view to a stored text
+/// stays valid until the arena is cleared.
+///
+class TextArena final {
+public:
+    /// The minimum number of characters in one chunk.
+    ///
+    static constexpr qsizetype cChunkSize = 0x10000;
+
+public:
+    /// Copy a text into the arena.
+    ///
+    /// @param text The text to copy.
+    /// @return A view to the copied text.
+    ///
+    auto store(QStringView text) -> QStringView;
+
+    /// Release all stored texts.
+    ///
+    /// One chunk of the default size is kept, to be reused for the next texts.
+    ///
+    void clear() noexcept;
+
+    /// Release all stored texts and free the memory of all chunks.
+    ///
+    void release() noexcept;
+
+private:
+    std::vector<std::unique_ptr<QChar[]>> _chunks; ///< The chunks with the texts.
+    qsizetype _chunkCapacity{}; ///< The capacity of the last chunk.
+    qsizetype _chunkUsed{}; ///< The number of used characters in the last chunk.
+};
+
+
+}
+
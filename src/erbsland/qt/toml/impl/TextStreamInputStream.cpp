@@ -4,8 +4,13 @@
 #include "TextStreamInputStream.hpp"
 
 
+#include "Utf8Validator.hpp"
+
 #include "../Error.hpp"
 
+#include <cstring>
+#include <utility>
+
 
 namespace erbsland::qt::toml::impl {
 
@@ -15,21 +20,104 @@ TextStreamInputStream::TextStreamInputStream(InputStream::Type type) noexcept
 }
 
 
+void TextStreamInputStream::setData(QByteArray data) noexcept {
+    _device = nullptr;
+    _buffer = std::move(data);
+    _position = 0;
+    _validatedEnd = 0;
+}
+
+
+void TextStreamInputStream::setDevice(QIODevice *device) noexcept {
+    _device = device;
+    _buffer.clear();
+    _buffer.reserve(cBlockSize + cMaximumCharacterSize);
+    _position = 0;
+    _validatedEnd = 0;
+}
+
+
 auto TextStreamInputStream::atEnd() noexcept -> bool {
-    return _dataStream->atEnd();
+    if (_position < _buffer.size()) {
+        return false;
+    }
+    return _device == nullptr || _device->atEnd();
 }
 
 
 auto TextStreamInputStream::readOrThrow() -> Char {
-    if (atEnd()) {
+    if (_position < _validatedEnd) {
+        return readValidated();
+    }
+    if (_position >= _buffer.size() && !fillBuffer()) {
         return {};
     }
-    auto data = readByte();
-    if (data < 0x80) {
-        return Char{static_cast<uint32_t>(data)};
+    validateBuffer();
+    if (_position < _validatedEnd) {
+        return readValidated();
+    }
+    // The data at the read position is either invalid, or a sequence that is incomplete at the end of the buffer.
+    if (byteAt(_position) < 0x80U) {
+        return Char{static_cast<char32_t>(byteAt(_position++))};
+    }
+    return readMultiByteOrThrow();
+}
+
+
+auto TextStreamInputStream::readBlockOrThrow(Char *buffer, qsizetype maximumSize) -> qsizetype {
+    qsizetype count = 0;
+    while (count < maximumSize) {
+        if (_position < _validatedEnd) {
+            buffer[count] = readValidated();
+        } else if (count == 0 && !atEnd()) {
+            buffer[count] = readOrThrow();
+        } else {
+            break; // stop before data that needs the checked decoder, so errors are reported with the next call.
+        }
+        count += 1;
+    }
+    return count;
+}
+
+
+auto TextStreamInputStream::completeData() const noexcept -> QByteArray {
+    if (_device != nullptr || _position != 0) {
+        return {};
+    }
+    return _buffer;
+}
+
+
+auto TextStreamInputStream::readValidated() noexcept -> Char {
+    const auto lead = byteAt(_position);
+    if (lead < 0x80U) {
+        _position += 1;
+        return Char{static_cast<char32_t>(lead)};
     }
-    uint8_t cSize = 0;
     uint32_t unicodeValue;
+    if (lead < 0b11100000U) {
+        unicodeValue = ((lead & 0b00011111U) << 6) | (byteAt(_position + 1) & 0b00111111U);
+        _position += 2;
+    } else if (lead < 0b11110000U) {
+        unicodeValue = ((lead & 0b00001111U) << 12) | ((byteAt(_position + 1) & 0b00111111U) << 6)
+            | (byteAt(_position + 2) & 0b00111111U);
+        _position += 3;
+    } else {
+        unicodeValue = ((lead & 0b00000111U) << 18) | ((byteAt(_position + 1) & 0b00111111U) << 12)
+            | ((byteAt(_position + 2) & 0b00111111U) << 6) | (byteAt(_position + 3) & 0b00111111U);
+        _position += 4;
+    }
+    return Char{unicodeValue};
+}
+
+
+auto TextStreamInputStream::readMultiByteOrThrow() -> Char {
+    if (_buffer.size() - _position < cMaximumCharacterSize) {
+        fillBuffer(); // make sure the whole sequence is in the buffer, if there is more data.
+    }
+    auto data = byteAt(_position++);
+    uint8_t cSize = 0;
+    uint32_t unicodeValue = 0;
     if ((data & 0b11100000U) == 0b11000000U) { // 2 Bytes
         if (data >= 0b11000010U) { // <127 values must not be encoded that way.
             cSize = 2;
@@ -48,10 +136,10 @@ auto TextStreamInputStream::readOrThrow() -> Char {
         throw Error::createEncoding(document(), {});
     }
     for (uint8_t i = 1; i < cSize; ++i) {
-        if (atEnd()) {
+        if (_position >= _buffer.size()) {
             throw Error::createEncoding(document(), {});
         }
-        data = readByte();
+        data = byteAt(_position++);
         if ((data & 0b11000000U) != 0b10000000U) {
             throw Error::createEncoding(document(), {});
         }
@@ -66,10 +154,31 @@ auto TextStreamInputStream::readOrThrow() -> Char {
 }
 
 
-auto TextStreamInputStream::readByte() noexcept -> uint8_t {
-    uint8_t result;
-    (*_dataStream) >> result;
-    return result;
+void TextStreamInputStream::validateBuffer() noexcept {
+    const auto *data = reinterpret_cast<const uint8_t*>(_buffer.constData());
+    _validatedEnd = _position + Utf8Validator::validLength(data + _position, _buffer.size() - _position);
+}
+
+
+auto TextStreamInputStream::fillBuffer() -> bool {
+    if (_device == nullptr) {
+        return false;
+    }
+    // Keep the bytes that were not read yet, e.g. from an incomplete UTF-8 sequence.
+    const auto remaining = _buffer.size() - _position;
+    if (remaining > 0 && _position > 0) {
+        std::memmove(_buffer.data(), _buffer.constData() + _position, static_cast<std::size_t>(remaining));
+    }
+    _position = 0;
+    _validatedEnd = 0;
+    _buffer.resize(remaining + cBlockSize);
+    const auto bytesRead = _device->read(_buffer.data() + remaining, cBlockSize);
+    if (bytesRead < 0) {
+        _buffer.resize(remaining);
+        throw Error::createIO(document(), *_device);
+    }
+    _buffer.resize(remaining + static_cast<qsizetype>(bytesRead));
+    return bytesRead > 0;
 }
 
 
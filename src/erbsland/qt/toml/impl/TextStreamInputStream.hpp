@@ -6,18 +6,35 @@
 
 #include "../InputStream.hpp"
 
-#include <QtCore/QDataStream>
+#include <QtCore/QByteArray>
+#include <QtCore/QIODevice>
+
+#include <cstdint>
 
 
 namespace erbsland::qt::toml::impl {
 
 
 /// @private
-/// The common input stream type that uses a QTextStream
+/// The common input stream type that decodes UTF-8 data.
+///
+/// The data is either a complete block of bytes, or it is read in large blocks from an IO device into
+/// an internal buffer. The UTF-8 data is decoded directly from this buffer. Before decoding, the buffer
+/// is validated in one pass by `Utf8Validator`, so the validated range is decoded without any checks.
+/// Only invalid data, and sequences that are incomplete at the end of a block, pass the checked decoder.
 ///
 class TextStreamInputStream : public InputStream {
 protected:
-    /// Create a new QTextStream based input stream.
+    /// The number of bytes read from the device in one block.
+    ///
+    static constexpr qsizetype cBlockSize = 0x10000;
+
+    /// The maximum number of bytes of an UTF-8 encoded character.
+    ///
+    static constexpr qsizetype cMaximumCharacterSize = 4;
+
+protected:
+    /// Create a new UTF-8 decoding input stream.
     ///
     /// @param type The type of the stream.
     ///
@@ -26,12 +43,67 @@ protected:
 public: // implement InputStream
     auto atEnd() noexcept -> bool override;
     auto readOrThrow() -> Char override;
+    auto readBlockOrThrow(Char *buffer, qsizetype maximumSize) -> qsizetype override;
 
-private:
-    auto readByte() noexcept -> uint8_t;
+public:
+    /// Get the complete data of this stream.
+    ///
+    /// @return The complete UTF-8 data, if the stream uses a block of data and nothing was read yet.
+    ///     Otherwise, an empty byte array.
+    ///
+    [[nodiscard]] auto completeData() const noexcept -> QByteArray;
 
 protected:
-    std::unique_ptr<QDataStream> _dataStream{}; ///< The data stream to read the data.
+    /// Use a complete block of data as input.
+    ///
+    /// The data is implicitly shared and not copied.
+    ///
+    /// @param data The UTF-8 encoded data.
+    ///
+    void setData(QByteArray data) noexcept;
+
+    /// Read the input block-wise from a device.
+    ///
+    /// @param device The device, which has to stay valid as long as this stream is used.
+    ///
+    void setDevice(QIODevice *device) noexcept;
+
+private:
+    /// Move the unread bytes to the start of the buffer and read the next block from the device.
+    ///
+    /// @return `true` if new data was read, `false` if there is no more data.
+    /// @throws Error if there was an error reading from the device.
+    ///
+    auto fillBuffer() -> bool;
+
+    /// Decode an UTF-8 sequence that starts with a byte >= 0x80.
+    ///
+    /// @return The decoded character.
+    /// @throws Error if there is an encoding error in the data.
+    ///
+    auto readMultiByteOrThrow() -> Char;
+
+    /// Decode a character from the validated range of the buffer.
+    ///
+    /// @return The decoded character.
+    ///
+    auto readValidated() noexcept -> Char;
+
+    /// Validate the buffer, starting at the current read position.
+    ///
+    void validateBuffer() noexcept;
+
+    /// Access a byte in the buffer.
+    ///
+    [[nodiscard]] inline auto byteAt(qsizetype position) const noexcept -> uint8_t {
+        return static_cast<uint8_t>(_buffer.constData()[position]);
+    }
+
+private:
+    QIODevice *_device{}; ///< The optional device to read the data from.
+    QByteArray _buffer{}; ///< The buffer with the data to decode.
+    qsizetype _position{}; ///< The read position in the buffer.
+    qsizetype _validatedEnd{}; ///< The end of the validated range in the buffer.
 };
 
 
@@ -15,9 +15,9 @@ auto Token::toDebugString() const noexcept -> QString {
         return tokenTypeToString(_type);
     }
     static auto reSpecialChars = QRegularExpression(R"([\p{C}]+)");
-    auto text = _text;
+    auto text = _text.toString();
     text.replace(reSpecialChars, " "); // in erbsland core, encode special characters.
-    return QStringLiteral("%1(\"%2\")").arg(tokenTypeToString(_type), _text);
+    return QStringLiteral("%1(\"%2\")").arg(tokenTypeToString(_type), _text.toString());
 }
 
 
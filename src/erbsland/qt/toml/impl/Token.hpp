@@ -4,13 +4,13 @@
 #pragma once
 
 
+#include "DateTimeFields.hpp"
 #include "TokenType.hpp"
 
 #include "../LocationRange.hpp"
 
 #include <QtCore/QString>
-
-#include <utility>
+#include <QtCore/QStringView>
 
 
 namespace erbsland::qt::toml::impl {
@@ -19,6 +19,9 @@ namespace erbsland::qt::toml::impl {
 /// @private
 /// Represents a token read from the tokenizer.
 ///
+/// The token does not own its text. The text is a slice of the source text, or stored in the text arena
+/// of the character reader, and stays valid until the tokenizer is reset.
+///
 class Token final {
 public:
     /// Create a token.
@@ -26,8 +29,8 @@ public:
     /// @param type The token type.
     /// @param text The token text.
     ///
-    inline Token(TokenType type, QString text) noexcept
-        : _type{type}, _text{std::move(text)} {
+    inline Token(TokenType type, QStringView text) noexcept
+        : _type{type}, _text{text} {
     }
 
     /// Create a token.
@@ -36,8 +39,19 @@ public:
     /// @param text The token text.
     /// @param range The location range.
     ///
-    inline Token(TokenType type, QString text, LocationRange range) noexcept
-        : _type{type}, _text{std::move(text)}, _range{range} {
+    inline Token(TokenType type, QStringView text, LocationRange range) noexcept
+        : _type{type}, _text{text}, _range{range} {
+    }
+
+    /// Create a date, time or date/time token.
+    ///
+    /// @param type The token type.
+    /// @param text The token text.
+    /// @param range The location range.
+    /// @param dateTimeFields The numbers of the date and time.
+    ///
+    inline Token(TokenType type, QStringView text, LocationRange range, const DateTimeFields &dateTimeFields) noexcept
+        : _type{type}, _text{text}, _range{range}, _dateTimeFields{dateTimeFields} {
     }
 
     // defaults
@@ -46,10 +60,10 @@ public:
     auto operator=(const Token&) noexcept -> Token& = default;
 
 public:
-    constexpr auto operator==(const Token &other) noexcept -> bool {
+    inline auto operator==(const Token &other) noexcept -> bool {
         return _type == other._type && _text == other._text;
     }
-    constexpr auto operator!=(const Token &other) noexcept -> bool {
+    inline auto operator!=(const Token &other) noexcept -> bool {
         return !operator==(other);
     }
 
@@ -62,7 +76,7 @@ public:
 
     /// Get the token text.
     ///
-    [[nodiscard]] inline auto text() const noexcept -> const QString& {
+    [[nodiscard]] inline auto text() const noexcept -> QStringView {
         return _text;
     }
 
@@ -84,6 +98,12 @@ public:
         return _range;
     }
 
+    /// Get the numbers of a date, time or date/time token.
+    ///
+    [[nodiscard]] inline auto dateTimeFields() const noexcept -> const DateTimeFields& {
+        return _dateTimeFields;
+    }
+
     /// Test if this token is a value.
     ///
     [[nodiscard]] auto isValue() const noexcept -> bool;
@@ -122,8 +142,9 @@ public:
 
 private:
     TokenType _type{TokenType::EndOfDocument}; ///< The type of the token.
-    QString _text{}; ///< The text of the token.
+    QStringView _text{}; ///< The text of the token.
     LocationRange _range{LocationRange::createNotSet()}; ///< The location range.
+    DateTimeFields _dateTimeFields{}; ///< The numbers of a date, time or date/time token.
 };
 
 
@@ -31,8 +31,8 @@ Tokenizer::Tokenizer(Specification specification) noexcept
 }
 
 
-void Tokenizer::startWithStream(const InputStreamPtr &inputStream) noexcept {
-    _reader.resetWithInputStream(inputStream);
+void Tokenizer::startWithStream(const InputStreamPtr &inputStream, const Location &startLocation) noexcept {
+    _reader.resetWithInputStream(inputStream, startLocation);
     _tokenContext = TokenContext::Structure;
     _valueNestingCount = 0;
     _stringQuotes = StringQuotes::None;
@@ -46,15 +46,24 @@ void Tokenizer::stop() {
 
 
 auto Tokenizer::createToken(TokenType tokenType) -> Token {
-    auto [buffer, range] = _reader.takeToken();
-    auto token = Token(tokenType, buffer, range);
+    auto [text, range] = _reader.takeToken();
+    auto token = Token(tokenType, text, range);
     _stringQuotes = StringQuotes::None;
     _stringMode = StringMode::None;
     return token;
 }
 
 
+auto Tokenizer::createDateTimeToken(TokenType tokenType) -> Token {
+    auto [text, range] = _reader.takeToken();
+    return {tokenType, text, range, _dateTimeFields};
+}
+
+
 auto Tokenizer::read() -> Token {
+    if (_skipWhitespaceAndComments) {
+        skipWhitespaceAndComments();
+    }
     if (_reader.atEnd()) {
         return createToken(TokenType::EndOfDocument);
     }
@@ -108,8 +117,29 @@ auto Tokenizer::readWhiteSpace() -> Token {
 
 
 auto Tokenizer::readComment() -> Token {
+    skipComment();
+    return createToken(TokenType::Comment);
+}
+
+
+void Tokenizer::skipWhitespaceAndComments() {
+    while (!_reader.atEnd()) {
+        _reader.readNextChar();
+        if (_reader.isWhiteSpace()) {
+            _reader.skipWhiteSpace();
+        } else if (_reader.isComment()) {
+            skipComment();
+        } else {
+            return;
+        }
+        _reader.discardToken();
+    }
+}
+
+
+void Tokenizer::skipComment() {
     if (_reader.skipCharAndTestAtEnd()) {
-        return createToken(TokenType::Comment); // # at the end of the stream is a valid comment.
+        return; // # at the end of the stream is a valid comment.
     }
     while (!_reader.isNewLineOrCarriageReturn()) {
         if (_reader.isControlCharacter()) {
@@ -119,7 +149,6 @@ auto Tokenizer::readComment() -> Token {
             break; // # comments that ends with the stream is valid.
         }
     }
-    return createToken(TokenType::Comment);
 }
 
 
@@ -562,8 +591,14 @@ auto Tokenizer::readOptionalFraction() -> StreamState {
     if (_reader.isDot()) {
         streamState = _reader.consumeChar();
         _reader.expectMoreData(streamState);
+        int fractionDigits = 0;
         for (int i = 0;; ++i) {
             if (_reader.isDecimalDigit()) {
+                if (fractionDigits < 9) { // only nanoseconds are kept.
+                    _dateTimeFields.nanosecond = _dateTimeFields.nanosecond * 10U
+                        + static_cast<uint32_t>(_reader.currentChar().toAscii() - '0');
+                    fractionDigits += 1;
+                }
                 streamState = _reader.consumeChar();
                 if (streamState == StreamState::EndOfStream) {
                     break;
@@ -575,21 +610,31 @@ auto Tokenizer::readOptionalFraction() -> StreamState {
                 _reader.throwSyntaxError(QStringLiteral("Too many digits for second fraction."));
             }
         }
+        for (; fractionDigits < 9; ++fractionDigits) {
+            _dateTimeFields.nanosecond *= 10U;
+        }
     }
     return streamState;
 }
 
 
 auto Tokenizer::readTimeZone() -> TokenType {
+    int32_t value;
     if (_reader.isUtcTimeZone()) {
         _reader.consumeChar();
+        _dateTimeFields.hasOffset = true;
         return TokenType::OffsetDateTime;
     }
     if (_reader.isPlusMinusSign()) {
+        _dateTimeFields.hasOffset = true;
+        _dateTimeFields.isNegativeOffset = (_reader.currentChar() == '-');
         _reader.consumeCharAndExpectMore();
-        _reader.consumeDecimalDigitsAndExpectMore(2);
+        _reader.consumeDecimalDigitsAndExpectMore(2, value);
+        _dateTimeFields.offsetHour = static_cast<uint8_t>(value);
         readTimeSeperator();
-        if (_reader.consumeDecimalDigitsAndTestAtEnd(2)) {
+        const auto atEnd = _reader.consumeDecimalDigitsAndTestAtEnd(2, value);
+        _dateTimeFields.offsetMinute = static_cast<uint8_t>(value);
+        if (atEnd) {
             return TokenType::OffsetDateTime;
         }
         expectValueEnd();
@@ -605,43 +650,56 @@ auto Tokenizer::readDate() -> Token {
     if (_reader.tokenSize() != 4) {
         _reader.throwSyntaxError(QStringLiteral("Unexpected minus character after integer value."));
     }
+    _dateTimeFields = {};
+    for (const auto c : _reader.token()) {
+        _dateTimeFields.year = static_cast<uint16_t>(_dateTimeFields.year * 10 + (c.unicode() - u'0'));
+    }
+    int32_t value;
     _reader.consumeCharAndExpectMore(); // consume the `-`
-    _reader.consumeDecimalDigitsAndExpectMore(2);
+    _reader.consumeDecimalDigitsAndExpectMore(2, value);
+    _dateTimeFields.month = static_cast<uint8_t>(value);
     readDateSeperator();
-    if (_reader.consumeDecimalDigitsAndTestAtEnd(2)) {
-        return createToken(TokenType::LocalDate);
+    const auto dayAtEnd = _reader.consumeDecimalDigitsAndTestAtEnd(2, value);
+    _dateTimeFields.day = static_cast<uint8_t>(value);
+    if (dayAtEnd) {
+        return createDateTimeToken(TokenType::LocalDate);
     }
     if (_reader.isDateAndTimeSeperator()) {
         if (_reader.isWhiteSpace()) {
             if (_reader.skipCharAndTestAtEnd()) {
-                return createToken(TokenType::LocalDate);
+                return createDateTimeToken(TokenType::LocalDate);
             }
             if (!_reader.isDecimalDigit()) {
                 expectValueEnd();
-                return createToken(TokenType::LocalDate);
+                return createDateTimeToken(TokenType::LocalDate);
             }
             _reader.writeToToken(Char{' '}); // write the skipped space to the token buffer.
         } else {
             _reader.consumeCharAndExpectMore();
         }
-        _reader.consumeDecimalDigitsAndExpectMore(2);
+        _reader.consumeDecimalDigitsAndExpectMore(2, value);
+        _dateTimeFields.hour = static_cast<uint8_t>(value);
         readTimeSeperator();
-        if (_reader.consumeDecimalDigitsAndTestAtEnd(2)) {
-            return createToken(TokenType::LocalDate);
+        const auto minuteAtEnd = _reader.consumeDecimalDigitsAndTestAtEnd(2, value);
+        _dateTimeFields.minute = static_cast<uint8_t>(value);
+        if (minuteAtEnd) {
+            return createDateTimeToken(TokenType::LocalDate);
         }
         if (_reader.isTimeSeperator()) { // has seconds?
             _reader.consumeCharAndExpectMore();
-            if (_reader.consumeDecimalDigitsAndTestAtEnd(2)) {
-                return createToken(TokenType::LocalDate);
+            const auto secondAtEnd = _reader.consumeDecimalDigitsAndTestAtEnd(2, value);
+            _dateTimeFields.second = static_cast<uint8_t>(value);
+            if (secondAtEnd) {
+                return createDateTimeToken(TokenType::LocalDate);
             }
             readOptionalFraction();
         } else if (_specification <= Specification::Version_1_0) {
             _reader.throwSyntaxError("Times without seconds are not supported in TOML 1.0.");
         }
-        return createToken(readTimeZone());
+        return createDateTimeToken(readTimeZone());
     }
     expectValueEnd();
-    return createToken(TokenType::LocalDate);
+    return createDateTimeToken(TokenType::LocalDate);
 }
 
 
@@ -649,19 +707,27 @@ auto Tokenizer::readTime() -> Token {
     if (_reader.tokenSize() != 2) {
         _reader.throwSyntaxError(QStringLiteral("Unexpected colon after integer value."));
     }
+    _dateTimeFields = {};
+    for (const auto c : _reader.token()) {
+        _dateTimeFields.hour = static_cast<uint8_t>(_dateTimeFields.hour * 10 + (c.unicode() - u'0'));
+    }
+    int32_t value;
     _reader.consumeCharAndExpectMore(); // consume the `:`
-    _reader.consumeDecimalDigitsAndExpectMore(2);
+    _reader.consumeDecimalDigitsAndExpectMore(2, value);
+    _dateTimeFields.minute = static_cast<uint8_t>(value);
     if (_reader.isTimeSeperator()) { // has seconds?
         _reader.consumeCharAndExpectMore();
-        if (_reader.consumeDecimalDigitsAndTestAtEnd(2)) {
-            return createToken(TokenType::LocalTime);
+        const auto secondAtEnd = _reader.consumeDecimalDigitsAndTestAtEnd(2, value);
+        _dateTimeFields.second = static_cast<uint8_t>(value);
+        if (secondAtEnd) {
+            return createDateTimeToken(TokenType::LocalTime);
         }
         readOptionalFraction();
     } else if (_specification <= Specification::Version_1_0) {
         _reader.throwSyntaxError("Times without seconds are not supported in TOML 1.0.");
     }
     expectValueEnd();
-    return createToken(TokenType::LocalTime);
+    return createDateTimeToken(TokenType::LocalTime);
 }
 
 
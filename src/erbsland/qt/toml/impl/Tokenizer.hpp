@@ -69,12 +69,31 @@ public:
 public: // high-level interface.
     /// Resets the tokenizer and assigns a new stream to tokenize.
     ///
-    void startWithStream(const InputStreamPtr &inputStream) noexcept;
+    /// @param inputStream The stream to tokenize.
+    /// @param startLocation The location of the first character in the stream.
+    ///
+    void startWithStream(const InputStreamPtr &inputStream, const Location &startLocation = {}) noexcept;
 
     /// Stops the tokenizer and frees the stream.
     ///
     void stop();
 
+    /// Release the texts of all tokens that were read so far.
+    ///
+    /// Call this method only if none of the previous tokens is used anymore, e.g. at the end of a statement.
+    ///
+    inline void releaseTokenTexts() noexcept { _reader.releaseTokenTexts(); }
+
+    /// Set if whitespace and comments are skipped.
+    ///
+    /// If enabled, whitespace and comments are consumed internally and `read()` never returns
+    /// `Whitespace` or `Comment` tokens. This is the mode for the parser. If disabled, which is the
+    /// default, these tokens are returned, e.g. for tools that need to keep the formatting of a document.
+    ///
+    /// @param skip `true` to skip whitespace and comments.
+    ///
+    inline void setSkipWhitespaceAndComments(bool skip) noexcept { _skipWhitespaceAndComments = skip; }
+
     /// Read the next token from the stream.
     ///
     /// @return The next token.
@@ -91,6 +110,10 @@ private: // token level functions.
     ///
     auto createToken(TokenType tokenType) -> Token;
 
+    /// Create a date, time or date/time token with the captured fields and clear the token buffer.
+    ///
+    auto createDateTimeToken(TokenType tokenType) -> Token;
+
     /// Read a next token in the structure context.
     ///
     auto readStructure() -> Token;
@@ -107,6 +130,14 @@ private: // token level functions.
     ///
     auto readComment() -> Token;
 
+    /// Skip all whitespace and comments, without creating tokens.
+    ///
+    void skipWhitespaceAndComments();
+
+    /// Skip a comment, without creating a token.
+    ///
+    void skipComment();
+
     /// Read a string.
     ///
     auto readString() -> Token;
@@ -225,6 +256,7 @@ public: // string handling.
 private:
     Specification _specification{}; ///< The version of the specification to use
     CharReader _reader; ///< The character reader.
+    bool _skipWhitespaceAndComments{false}; ///< If whitespace and comments are skipped.
     // constants
     static const std::vector<const char*> _floatSpecials; ///< Float special values
     static const std::vector<const char*> _booleanValues; ///< Boolean values.
@@ -235,6 +267,7 @@ private:
     StringQuotes _stringQuotes{StringQuotes::None}; ///< The current string quotes.
     StringMode _stringMode{StringMode::None}; ///< The current string mode.
     ReadSign _readSign{ReadSign::None}; ///< A sign that was read in front of an integer or float.
+    DateTimeFields _dateTimeFields{}; ///< The numbers of the current date or time token.
 };
 
 
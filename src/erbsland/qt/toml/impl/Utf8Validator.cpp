@@ -0,0 +1,250 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "Utf8Validator.hpp"
+
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ERBSLAND_QT_TOML_SSE2
+#endif
+#if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+#define ERBSLAND_QT_TOML_AVX2
+#endif
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define ERBSLAND_QT_TOML_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(ERBSLAND_QT_TOML_AVX2) && (defined(__GNUC__) || defined(__clang__))
+#define ERBSLAND_QT_TOML_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define ERBSLAND_QT_TOML_TARGET_AVX2
+#endif
+
+
+namespace erbsland::qt::toml::impl {
+
+
+namespace {
+
+
+/// The function type for the ASCII detection.
+///
+using AsciiLengthFunction = qsizetype(*)(const uint8_t*, qsizetype) noexcept;
+
+
+/// Get the index of the lowest bit that is set in a non-zero mask.
+///
+inline auto lowestBitIndex(uint32_t mask) noexcept -> qsizetype {
+#if defined(_MSC_VER) && !defined(__clang__)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<qsizetype>(index);
+#else
+    return static_cast<qsizetype>(__builtin_ctz(mask));
+#endif
+}
+
+
+/// The portable implementation that tests eight bytes at once.
+///
+auto asciiLengthScalar(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    qsizetype position = 0;
+    while (position + 8 <= size) {
+        uint64_t word;
+        std::memcpy(&word, data + position, sizeof(word));
+        if ((word & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+        position += 8;
+    }
+    while (position < size && data[position] < 0x80U) {
+        position += 1;
+    }
+    return position;
+}
+
+
+#ifdef ERBSLAND_QT_TOML_SSE2
+/// The SSE2 implementation that tests 16 bytes at once.
+///
+auto asciiLengthSse2(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    qsizetype position = 0;
+    while (position + 16 <= size) {
+        const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + position));
+        const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(block));
+        if (mask != 0) {
+            return position + lowestBitIndex(mask);
+        }
+        position += 16;
+    }
+    return position + asciiLengthScalar(data + position, size - position);
+}
+#endif
+
+
+#ifdef ERBSLAND_QT_TOML_AVX2
+/// The AVX2 implementation that tests 32 bytes at once.
+///
+ERBSLAND_QT_TOML_TARGET_AVX2
+auto asciiLengthAvx2(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    qsizetype position = 0;
+    while (position + 32 <= size) {
+        const auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + position));
+        const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+        if (mask != 0) {
+            return position + lowestBitIndex(mask);
+        }
+        position += 32;
+    }
+    return position + asciiLengthScalar(data + position, size - position);
+}
+
+
+/// Test if the CPU and the operating system support AVX2 instructions.
+///
+auto hasAvx2() noexcept -> bool {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) {
+        return false;
+    }
+    __cpuid(info, 1);
+    const bool hasOsxsave = (info[2] & (1 << 27)) != 0;
+    const bool hasAvx = (info[2] & (1 << 28)) != 0;
+    if (!hasOsxsave || !hasAvx || (_xgetbv(0) & 0x6U) != 0x6U) {
+        return false;
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+#endif
+
+
+#ifdef ERBSLAND_QT_TOML_NEON
+/// The NEON implementation that tests 16 bytes at once.
+///
+auto asciiLengthNeon(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    qsizetype position = 0;
+    while (position + 16 <= size) {
+        const auto block = vld1q_u8(data + position);
+        if (vmaxvq_u8(block) >= 0x80U) {
+            break;
+        }
+        position += 16;
+    }
+    return position + asciiLengthScalar(data + position, size - position);
+}
+#endif
+
+
+/// Select the best ASCII detection for the current CPU.
+///
+auto selectAsciiLength() noexcept -> AsciiLengthFunction {
+#ifdef ERBSLAND_QT_TOML_AVX2
+    if (hasAvx2()) {
+        return &asciiLengthAvx2;
+    }
+#endif
+#if defined(ERBSLAND_QT_TOML_SSE2)
+    return &asciiLengthSse2;
+#elif defined(ERBSLAND_QT_TOML_NEON)
+    return &asciiLengthNeon;
+#else
+    return &asciiLengthScalar;
+#endif
+}
+
+
+/// Test if a byte is in the given range.
+///
+inline auto isInRange(uint8_t byte, uint8_t first, uint8_t last) noexcept -> bool {
+    return byte >= first && byte <= last;
+}
+
+
+}
+
+
+auto Utf8Validator::asciiLength(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    static const auto function = selectAsciiLength();
+    return function(data, size);
+}
+
+
+auto Utf8Validator::validLength(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    qsizetype position = 0;
+    while (position < size) {
+        position += asciiLength(data + position, size - position);
+        while (position < size && data[position] >= 0x80U) {
+            const auto length = sequenceLength(data + position, size - position);
+            if (length == 0) {
+                return position;
+            }
+            position += length;
+        }
+    }
+    return position;
+}
+
+
+auto Utf8Validator::sequenceLength(const uint8_t *data, qsizetype size) noexcept -> qsizetype {
+    // See "Table 3-7. Well-Formed UTF-8 Byte Sequences" in the Unicode standard.
+    const auto lead = data[0];
+    if (isInRange(lead, 0xc2U, 0xdfU)) {
+        if (size < 2 || !isInRange(data[1], 0x80U, 0xbfU)) {
+            return 0;
+        }
+        return 2;
+    }
+    if (isInRange(lead, 0xe0U, 0xefU)) {
+        if (size < 3) {
+            return 0;
+        }
+        uint8_t first = 0x80U;
+        uint8_t last = 0xbfU;
+        if (lead == 0xe0U) {
+            first = 0xa0U; // overlong encoding.
+        } else if (lead == 0xedU) {
+            last = 0x9fU; // surrogates.
+        }
+        if (!isInRange(data[1], first, last) || !isInRange(data[2], 0x80U, 0xbfU)) {
+            return 0;
+        }
+        return 3;
+    }
+    if (isInRange(lead, 0xf0U, 0xf4U)) {
+        if (size < 4) {
+            return 0;
+        }
+        uint8_t first = 0x80U;
+        uint8_t last = 0xbfU;
+        if (lead == 0xf0U) {
+            first = 0x90U; // overlong encoding.
+        } else if (lead == 0xf4U) {
+            last = 0x8fU; // values above U+10FFFF.
+        }
+        if (!isInRange(data[1], first, last) || !isInRange(data[2], 0x80U, 0xbfU)
+            || !isInRange(data[3], 0x80U, 0xbfU)) {
+            return 0;
+        }
+        return 4;
+    }
+    return 0;
+}
+
+
+}
+
@@ -0,0 +1,53 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <QtCore/QtGlobal>
+
+#include <cstdint>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// Fast validation of UTF-8 encoded data.
+///
+/// Runs of 7-bit ASCII characters are detected using vector instructions (SSE2 or AVX2 on x86, NEON on ARM).
+/// The best implementation for the current CPU is selected at runtime, with a portable scalar implementation
+/// as fallback. Multi-byte sequences are validated strictly: Overlong encodings, surrogates and values
+/// above U+10FFFF are rejected.
+///
+class Utf8Validator final {
+public:
+    /// Get the number of 7-bit ASCII characters at the start of the data.
+    ///
+    /// @param data The data to test.
+    /// @param size The size of the data in bytes.
+    /// @return The number of bytes before the first byte >= 0x80, or `size` if all bytes are ASCII.
+    ///
+    [[nodiscard]] static auto asciiLength(const uint8_t *data, qsizetype size) noexcept -> qsizetype;
+
+    /// Get the number of bytes at the start of the data that form complete and valid UTF-8 sequences.
+    ///
+    /// @param data The data to validate.
+    /// @param size The size of the data in bytes.
+    /// @return The number of bytes before the first invalid or incomplete sequence, or `size` if the
+    ///     whole data is valid.
+    ///
+    [[nodiscard]] static auto validLength(const uint8_t *data, qsizetype size) noexcept -> qsizetype;
+
+    /// Get the size of a strictly valid UTF-8 sequence that starts with a byte >= 0x80.
+    ///
+    /// @param data The data with the sequence.
+    /// @param size The number of available bytes.
+    /// @return The size of the sequence in bytes, or zero if the sequence is not valid or incomplete.
+    ///
+    [[nodiscard]] static auto sequenceLength(const uint8_t *data, qsizetype size) noexcept -> qsizetype;
+};
+
+
+}
+
@@ -0,0 +1,76 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "ValueArena.hpp"
+
+
+#include <new>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+ValueArena::~ValueArena() {
+    // Destroy the values in the reverse order of their creation.
+    for (auto blockIt = _blocks.rbegin(); blockIt != _blocks.rend(); ++blockIt) {
+        const auto count = (blockIt == _blocks.rbegin()) ? _usedInLastBlock : cValuesPerBlock;
+        auto *values = std::launder(reinterpret_cast<Value*>((*blockIt)->data));
+        for (auto i = count; i > 0; --i) {
+            values[i - 1].~Value();
+        }
+    }
+}
+
+
+auto ValueArena::create() noexcept -> ValueArenaPtr {
+    return std::make_shared<ValueArena>(PrivateTag{});
+}
+
+
+auto ValueArena::createScalarTextValue(
+    ValueArena *arena,
+    Value::Type type,
+    QStringView text) noexcept -> ValuePtr {
+
+    if (text.size() > static_cast<qsizetype>(Value::ScalarText::cCapacity)) {
+        return {};
+    }
+    Value::ScalarText scalarText{};
+    for (qsizetype i = 0; i < text.size(); ++i) {
+        scalarText.text[static_cast<std::size_t>(i)] = static_cast<char>(text[i].unicode());
+    }
+    scalarText.size = static_cast<uint8_t>(text.size());
+    return createValue(arena, type, Value::Source::Value, scalarText);
+}
+
+
+auto ValueArena::ownerPtr(const Value *value) const noexcept -> ValuePtr {
+    return {std::const_pointer_cast<ValueArena>(shared_from_this()), const_cast<Value*>(value)};
+}
+
+
+auto ValueArena::linkPtr(const ValuePtr &value) noexcept -> ValuePtr {
+    return {ValuePtr{}, value.get()};
+}
+
+
+auto ValueArena::allocateLocationRange() noexcept -> LocationRange* {
+    return &_locationRanges.emplace_back();
+}
+
+
+auto ValueArena::allocate(Value::Type type, Value::Source source, Value::Storage storage) noexcept -> ValuePtr {
+    if (_usedInLastBlock == cValuesPerBlock) {
+        _blocks.emplace_back(new Block); // no need to initialize the storage.
+        _usedInLastBlock = 0;
+    }
+    auto *address = _blocks.back()->data + sizeof(Value) * _usedInLastBlock;
+    auto *value = new (address) Value{type, source, std::move(storage), Value::PrivateTag{}};
+    _usedInLastBlock += 1;
+    value->_arena = this;
+    return ownerPtr(value);
+}
+
+
+}
+
@@ -0,0 +1,134 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include "../Value.hpp"
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <vector>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+class ValueArena;
+using ValueArenaPtr = std::shared_ptr<ValueArena>; ///< A shared pointer for the value arena.
+
+
+/// @private
+/// A monotonic arena that owns all values of a parsed document.
+///
+/// Values are placed in large blocks instead of separate heap allocations. A `ValuePtr` to a value in
+/// the arena is an aliasing pointer that shares the ownership of the whole arena. Links between values of
+/// the same arena do not own the arena, so there are no cycles. The arena, and with it all values, is
+/// destroyed when the last pointer to one of its values is released.
+///
+/// The location ranges of the values are stored in a side table of the arena.
+///
+class ValueArena final : public std::enable_shared_from_this<ValueArena> {
+public:
+    /// The number of values in one block.
+    ///
+    static constexpr std::size_t cValuesPerBlock = 256;
+
+private:
+    /// A block of storage for values.
+    ///
+    struct Block {
+        alignas(Value) std::byte data[sizeof(Value) * cValuesPerBlock]; ///< The storage.
+    };
+
+    /// A tag for the private constructor.
+    ///
+    struct PrivateTag {};
+
+public:
+    /// @private
+    /// The private constructor.
+    ///
+    explicit ValueArena(PrivateTag /*unused*/) noexcept {}
+
+    /// Destroy all values of the arena.
+    ///
+    ~ValueArena();
+
+    // no copy and assignment.
+    ValueArena(const ValueArena&) = delete;
+    auto operator=(const ValueArena&) = delete;
+
+public:
+    /// Create a new empty arena.
+    ///
+    [[nodiscard]] static auto create() noexcept -> ValueArenaPtr;
+
+    /// Create a new value.
+    ///
+    /// @param arena The arena for the value, or `nullptr` to create a regular shared value.
+    /// @param type The type of the value.
+    /// @param source The source of the value.
+    /// @param value The value.
+    /// @return A pointer to the new value, that shares the ownership of the arena.
+    ///
+    template<typename T>
+    [[nodiscard]] static auto createValue(
+        ValueArena *arena,
+        Value::Type type,
+        Value::Source source,
+        T value) noexcept -> ValuePtr {
+
+        if (arena == nullptr) {
+            return std::make_shared<Value>(type, source, Value::Storage{std::move(value)}, Value::PrivateTag{});
+        }
+        return arena->allocate(type, source, Value::Storage{std::move(value)});
+    }
+
+    /// Create a new scalar value, that is converted from its text on the first access.
+    ///
+    /// @param arena The arena for the value, or `nullptr` to create a regular shared value.
+    /// @param type The type of the value, which must be a type that is stored as text.
+    /// @param text The verified ASCII text of the token.
+    /// @return A pointer to the new value, or `nullptr` if the text is too long to store it in the value.
+    ///
+    [[nodiscard]] static auto createScalarTextValue(
+        ValueArena *arena,
+        Value::Type type,
+        QStringView text) noexcept -> ValuePtr;
+
+    /// Get an owning pointer to a value of this arena.
+    ///
+    /// @param value The value, which must be part of this arena.
+    /// @return A pointer that shares the ownership of the arena.
+    ///
+    [[nodiscard]] auto ownerPtr(const Value *value) const noexcept -> ValuePtr;
+
+    /// Get a non-owning pointer to a value, for links between values of the same arena.
+    ///
+    /// @param value The value.
+    /// @return A pointer to the value, that does not share the ownership of the arena.
+    ///
+    [[nodiscard]] static auto linkPtr(const ValuePtr &value) noexcept -> ValuePtr;
+
+    /// Allocate a new location range for a value of this arena, that is too large to be stored in the value.
+    ///
+    /// @return A pointer to the location range, that stays valid as long as the arena exists.
+    ///
+    [[nodiscard]] auto allocateLocationRange() noexcept -> LocationRange*;
+
+private:
+    /// Allocate and construct a new value in the arena.
+    ///
+    auto allocate(Value::Type type, Value::Source source, Value::Storage storage) noexcept -> ValuePtr;
+
+private:
+    std::vector<std::unique_ptr<Block>> _blocks; ///< The blocks with the values.
+    std::size_t _usedInLastBlock{cValuesPerBlock}; ///< The number of values in the last block.
+    std::deque<LocationRange> _locationRanges; ///< The location ranges that are too large for the values.
+};
+
+
+}
+
@@ -0,0 +1,74 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#include "WorkerGroup.hpp"
+
+
+#include <QtCore/QMutex>
+#include <QtCore/QMutexLocker>
+#include <QtCore/QThreadPool>
+#include <QtCore/QWaitCondition>
+
+#include <algorithm>
+#include <memory>
+
+
+namespace erbsland::qt::toml::impl {
+
+
+namespace {
+
+
+/// The state that is shared with all workers.
+///
+/// The state is shared with the tasks in the thread pool, as tasks that are started after the calling
+/// thread returned still access it.
+///
+struct WorkerState {
+    QMutex mutex; ///< The mutex for the counter and flag.
+    QWaitCondition workersDone; ///< Signalled when the last active worker is done.
+    int activeWorkers{0}; ///< The number of active workers.
+    bool isClosed{false}; ///< If no new workers may start.
+};
+
+
+}
+
+
+auto WorkerGroup::workerCount(QThreadPool *threadPool, std::size_t taskCount) noexcept -> std::size_t {
+    const auto threadCount = static_cast<std::size_t>(std::max(threadPool->maxThreadCount(), 1));
+    return std::min(threadCount, taskCount);
+}
+
+
+void WorkerGroup::run(QThreadPool *threadPool, std::size_t workerCount, const std::function<void()> &worker) noexcept {
+    auto state = std::make_shared<WorkerState>();
+    auto task = [state, &worker]() {
+        {
+            QMutexLocker locker{&state->mutex};
+            if (state->isClosed) {
+                return; // the calling thread may already be gone.
+            }
+            state->activeWorkers += 1;
+        }
+        worker();
+        QMutexLocker locker{&state->mutex};
+        state->activeWorkers -= 1;
+        if (state->activeWorkers == 0) {
+            state->workersDone.wakeAll();
+        }
+    };
+    for (std::size_t i = 1; i < workerCount; ++i) {
+        threadPool->start(task);
+    }
+    worker();
+    QMutexLocker locker{&state->mutex};
+    state->isClosed = true;
+    while (state->activeWorkers > 0) {
+        state->workersDone.wait(&state->mutex);
+    }
+}
+
+
+}
+
@@ -0,0 +1,46 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+#pragma once
+
+
+#include <cstddef>
+#include <functional>
+
+
+class QThreadPool;
+
+
+namespace erbsland::qt::toml::impl {
+
+
+/// @private
+/// Runs a worker function on multiple threads of a thread pool.
+///
+/// The calling thread is one of the workers, so `run()` returns even if all threads of the pool are busy,
+/// or if it is called from a thread of the pool. Workers started by the pool after the calling thread
+/// finished its work return without calling the worker function. The workers have to distribute the work
+/// between themselves, e.g. using an atomic index.
+///
+class WorkerGroup final {
+public:
+    /// Get the number of workers to use for a number of tasks.
+    ///
+    /// @param threadPool The thread pool.
+    /// @param taskCount The number of tasks.
+    /// @return The number of workers, which is never larger than the number of tasks.
+    ///
+    [[nodiscard]] static auto workerCount(QThreadPool *threadPool, std::size_t taskCount) noexcept -> std::size_t;
+
+    /// Run a worker function on multiple threads and wait until all workers are done.
+    ///
+    /// @param threadPool The thread pool.
+    /// @param workerCount The number of workers, including the calling thread.
+    /// @param worker The worker function, which must not throw any exceptions.
+    ///
+    static void run(QThreadPool *threadPool, std::size_t workerCount, const std::function<void()> &worker) noexcept;
+};
+
+
+}
+
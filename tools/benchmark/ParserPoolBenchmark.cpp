@@ -0,0 +1,120 @@
+// Copyright © 2023-2024 Tobias Erbsland https://erbsland.dev/ and EducateIT GmbH https://educateit.ch
+// According to the copyright terms specified in the file "COPYRIGHT.md".
+// SPDX-License-Identifier: LGPL-3.0-or-later
+
+
+// Measures how `ParserPool` scales with the number of threads.
+//
+// The benchmark parses the same list of generated documents with 1, 2, 4, ... threads, up to the number
+// of cores, and prints the best time of several runs for each thread count.
+//
+// Usage: parser-pool-benchmark [document count] [tables per document]
+
+
+#include <erbsland/qt/toml/ParserPool.hpp>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QList>
+#include <QtCore/QThread>
+#include <QtCore/QThreadPool>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+
+using namespace erbsland::qt::toml;
+
+
+namespace {
+
+
+constexpr int cRunCount = 5; ///< The number of runs for each thread count.
+
+
+/// Create a document with a number of tables, that uses the common value types.
+///
+auto createDocument(int documentIndex, int tableCount) -> QByteArray {
+    QByteArray result;
+    result.append("title = \"Document ").append(QByteArray::number(documentIndex)).append("\"\n");
+    result.append("created = 2024-02-12T10:21:33.123Z\n\n");
+    for (int i = 0; i < tableCount; ++i) {
+        result.append("[[server]]\n");
+        result.append("name = \"server-").append(QByteArray::number(i)).append("\"\n");
+        result.append("port = ").append(QByteArray::number(8000 + i)).append("\n");
+        result.append("weight = ").append(QByteArray::number(0.5 + i * 0.25)).append("\n");
+        result.append("enabled = true\n");
+        result.append("tags = [\"alpha\", \"beta\", \"gamma\"]\n");
+        result.append("limits = { connections = 100, timeout = 30.5 }\n\n");
+    }
+    return result;
+}
+
+
+/// Parse all documents with a number of threads, and return the best time in milliseconds.
+///
+auto measure(const QList<QByteArray> &documents, int threadCount) -> double {
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount); // the calling thread is one of the workers.
+    ParserPool pool{Specification::Version_1_0, &threadPool};
+    static_cast<void>(pool.parseDataList(documents)); // warm up the threads and parsers.
+    double bestTime = 0.0;
+    for (int run = 0; run < cRunCount; ++run) {
+        QElapsedTimer timer;
+        timer.start();
+        const auto results = pool.parseDataList(documents);
+        const auto time = static_cast<double>(timer.nsecsElapsed()) / 1'000'000.0;
+        const auto failed = std::any_of(results.begin(), results.end(), [](const ParserPool::Result &result) {
+            return result.value == nullptr;
+        });
+        if (failed) {
+            std::fprintf(stderr, "A document could not be parsed.\n");
+            std::exit(1);
+        }
+        if (run == 0 || time < bestTime) {
+            bestTime = time;
+        }
+    }
+    return bestTime;
+}
+
+
+}
+
+
+auto main(int argc, char *argv[]) -> int {
+    const int documentCount = (argc > 1) ? std::atoi(argv[1]) : 1000;
+    const int tableCount = (argc > 2) ? std::atoi(argv[2]) : 200;
+    if (documentCount <= 0 || tableCount <= 0) {
+        std::fprintf(stderr, "Usage: %s [document count] [tables per document]\n", argv[0]);
+        return 1;
+    }
+    QList<QByteArray> documents;
+    qsizetype totalSize = 0;
+    for (int i = 0; i < documentCount; ++i) {
+        documents.append(createDocument(i, tableCount));
+        totalSize += documents.back().size();
+    }
+    const int coreCount = std::max(QThread::idealThreadCount(), 1);
+    std::vector<int> threadCounts;
+    for (int threadCount = 1; threadCount < coreCount; threadCount *= 2) {
+        threadCounts.push_back(threadCount);
+    }
+    threadCounts.push_back(coreCount);
+
+    std::printf("%d documents, %.1f MiB, %d cores, best of %d runs\n",
+        documentCount, static_cast<double>(totalSize) / (1024.0 * 1024.0), coreCount, cRunCount);
+    std::printf("%8s %12s %12s %10s\n", "threads", "time [ms]", "MiB/s", "speedup");
+    double singleThreadTime = 0.0;
+    for (const auto threadCount : threadCounts) {
+        const auto time = measure(documents, threadCount);
+        if (threadCount == 1) {
+            singleThreadTime = time;
+        }
+        const auto throughput = static_cast<double>(totalSize) / (1024.0 * 1024.0) / (time / 1000.0);
+        std::printf("%8d %12.1f %12.1f %9.2fx\n", threadCount, time, throughput, singleThreadTime / time);
+    }
+    return 0;
+}